@@ -17,41 +17,168 @@
  */
 
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <ctime>
+#include <optional>
+#include <string>
 #include "src/Config.h"
 #include "src/Piece.h"
 #include "src/Game.h"
 #include "src/Audio.h"
 #include "src/UI.h"
+#include "src/Input.h"
+#include "src/AssetPack.h"
+#include "src/Persist.h"
+#include "src/Jobs.h"
+#include "src/Leaderboard.h"
+#include "src/Telemetry.h"
+#include "src/Versus.h"
+#include "src/Spectate.h"
+#include "src/SpectateProtocol.h"
+#include "src/Practice.h"
+#include "src/Render.h"
+#include "src/AllocStats.h"
+#include "src/Replay.h"
+#include "src/Training.h"
+#include "src/TileShader.h"
+#include "src/Export.h"
 
 using namespace sf;
 
 /** Process main */
-int main() {
+int main(int argc, char** argv) {
+    Clock startupClock;
+    std::string versusRelay;
+    std::string broadcastEndpoint;
+    std::string watchEndpoint;
+    std::string trainDir;
+    Export::Options exportOptions;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--versus") {
+            versusRelay = (i + 1 < argc) ? argv[++i] : "127.0.0.1";
+        }
+        else if (std::string(argv[i]) == "--broadcast") {
+            broadcastEndpoint = (i + 1 < argc) ? argv[++i] : std::to_string(SPECTATE_PORT);
+        }
+        else if (std::string(argv[i]) == "--watch") {
+            watchEndpoint = (i + 1 < argc) ? argv[++i] : "127.0.0.1";
+        }
+        else if (std::string(argv[i]) == "--record") {
+            Replay::setAutoRecord(true);
+        }
+        else if (std::string(argv[i]) == "--train") {
+            trainDir = (i + 1 < argc) ? argv[++i] : "pgo/corpus";
+        }
+        else if (std::string(argv[i]) == "--classic-tiles") {
+            TileShader::setEnabled(false);
+        }
+        else if (std::string(argv[i]) == "--export" && i + 1 < argc) {
+            exportOptions.replay = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--out" && i + 1 < argc) {
+            exportOptions.out = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--size" && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%ux%u", &exportOptions.width, &exportOptions.height) != 2) {
+                exportOptions.width = exportOptions.height = 0;
+            }
+        }
+        else if (std::string(argv[i]) == "--fps" && i + 1 < argc) {
+            exportOptions.fps = std::atoi(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "--png") {
+            exportOptions.format = Export::Format::PNG;
+        }
+    }
+
     srand(static_cast<unsigned>(time(nullptr)));
-    
-    loadHighScore();
-    loadSettings();
+    Assets::open();
+    Persist::start();
+    Jobs::start();
+
+    // An export renders a replay offscreen and exits without a window.
+    if (!exportOptions.replay.empty()) {
+        Font exportFont;
+        int result = 1;
+        if (Assets::loadFont(exportFont, "fonts/Monocraft.ttf")) {
+            UI::prewarmGlyphs(exportFont);
+            result = Export::run(exportOptions, exportFont);
+        }
+        Jobs::stop();
+        Persist::stop();
+        Assets::close();
+        return result;
+    }
+
+    // Disk-bound startup work runs on the job workers while the window
+    // opens and shows a loading bar. Audio needs the saved volumes first.
+    // The font's glyph pages are filled for every UI size before the
+    // first screen draws text; the loading bar itself uses no font.
+    // Settings are per thread, so the loaded ones are copied back here.
+    Jobs::Group dataLoad, fontLoad, iconLoad;
+    bool audioOk = false, fontOk = false, iconOk = false;
+    SettingsSnapshot loadedSettings;
+    Jobs::run(dataLoad, [&audioOk, &loadedSettings] {
+        loadHighScore();
+        loadSettings();
+        Leaderboard::load();
+        audioOk = Audio::init();
+        saveSettingsSnapshot(loadedSettings);
+    });
+
+    Font font;
+    Jobs::run(fontLoad, [&font, &fontOk] {
+        fontOk = Assets::loadFont(font, "fonts/Monocraft.ttf");
+        if (fontOk) UI::prewarmGlyphs(font);
+    });
+
+    sf::Image icon;
+    Jobs::run(iconLoad, [&icon, &iconOk] {
+        iconOk = Assets::loadImage(icon, "logo.png");
+    });
     
     sf::ContextSettings settings;
     settings.antiAliasingLevel = 8;
     bool isFullscreen = false;
     RenderWindow window(VideoMode({WINDOW_W, WINDOW_H}), "TETRIS", sf::Style::Default, sf::State::Windowed, settings);
-    window.setFramerateLimit(60);
+    window.setFramerateLimit(TARGET_FPS);
     
 /** Process window */
     sf::View gameView(sf::FloatRect({0, 0}, {(float)WINDOW_W, (float)WINDOW_H}));
     window.setView(gameView);
 
-    sf::Image icon;
-    if (icon.loadFromFile("assets/logo.png")) {
-        window.setIcon(icon);
-    }
+    float firstFrameMs = -1.f;
+    while (window.isOpen()) {
+        while (auto eventOpt = window.pollEvent()) {
+            if (eventOpt->is<Event::Closed>()) window.close();
+        }
 
-    Font font;
-    if (!font.openFromFile("assets/fonts/Monocraft.ttf")) return -1;
+        int loaded = (Jobs::done(dataLoad) ? 1 : 0) + (Jobs::done(fontLoad) ? 1 : 0) + (Jobs::done(iconLoad) ? 1 : 0);
+        window.clear(Color::Black);
+        UI::drawLoadingScreen(window, loaded / 3.f);
+        window.display();
+        if (firstFrameMs < 0.f) firstFrameMs = startupClock.getElapsedTime().asSeconds() * 1000.f;
+
+        if (loaded == 3) break;
+    }
 
-    if (!Audio::init()) return -1;
+    Jobs::wait(dataLoad);
+    Jobs::wait(fontLoad);
+    Jobs::wait(iconLoad);
+    restoreSettingsSnapshot(loadedSettings);
+    if (iconOk) {
+        window.setIcon(icon);
+    }
+    if (!window.isOpen() || !fontOk || !audioOk) {
+        Jobs::stop();
+        Persist::stop();
+        Audio::cleanup();
+        Assets::close();
+        return window.isOpen() ? -1 : 0;
+    }
 
     initBoard();
     currentPiece = createRandomPiece();
@@ -62,29 +189,94 @@ int main() {
 
     GameState state = GameState::MENU;
     GameState previousState = GameState::MENU;
-    Clock timer;
+    if (!versusRelay.empty() && Versus::connect(versusRelay)) {
+        state = GameState::PLAYING;
+    }
+    if (!watchEndpoint.empty() && Spectate::watch(watchEndpoint)) {
+        state = GameState::PLAYING;
+    }
+    if (!broadcastEndpoint.empty()) {
+        Spectate::startServer(broadcastEndpoint);
+    }
+    std::uint8_t heldKeys = 0;
+    std::uint8_t tappedKeys = 0;
     Clock frameClock;
-    SidebarUI sidebarUI = UI::makeSidebarUI();
+    const Cursor handCursor(Cursor::Type::Hand);
+    const Cursor arrowCursor(Cursor::Type::Arrow);
+    int shownCursor = -1;
     bool shouldClose = false;
-    bool blockInput = false;
+    bool startupReported = false;
+    bool hasFocus = true;
+    bool debugOverlay = false;
+    bool needsRedraw = true;
+    double simTime = Input::now();
+    std::optional<Event> pendingEvent;
 
-    const float fieldOffsetX = STATS_W;
+    auto nextEvent = [&]() -> std::optional<Event> {
+        if (pendingEvent) {
+            std::optional<Event> event = pendingEvent;
+            pendingEvent.reset();
+            return event;
+        }
+        return window.pollEvent();
+    };
 
     const float fullW = WINDOW_W;
     const float goBtnW = 280.f;
     const float goBtnX = (fullW - goBtnW) / 2.f;
 
+    // A training run replays the corpus instead of taking input, then exits.
+    // Its headless pass happens here and must not count as frame time.
+    bool trainingFailed = !trainDir.empty() && !Training::start(trainDir);
+    if (trainingFailed) shouldClose = true;
+    frameClock.restart();
+
 /** Play background music */
     Audio::playMusic();
+    Input::start();
+
+    // From here on the render thread owns the window's GL context.
+    (void)window.setActive(false);
+    Render::start(window, font);
 
     while (window.isOpen() && !shouldClose) {
+        AllocStats::Scope simScope(AllocStats::Subsystem::SIM);
+
+        // Menus, pause and game over are static: sleep until an event
+        // arrives instead of publishing unchanged frames. During play the
+        // loop ticks every SIM_TICK_MS; drawing happens on the render
+        // thread, so a slow frame never holds up gravity or lock timing.
+        // A game in an unfocused window takes no input, so it only ticks
+        // at BACKGROUND_FPS; versus, spectating and training keep up with
+        // the network or the bot.
+        bool versus = Versus::phase() != Versus::Phase::OFF;
+        bool watching = Spectate::watching();
+        bool training = Training::active();
+        bool isIdle = !versus && !watching && !training && (state != GameState::PLAYING || isGameOver);
+        if (isIdle && !needsRedraw) {
+            pendingEvent = window.waitEvent(sf::milliseconds(IDLE_WAIT_MS));
+            frameClock.restart();
+            simTime = Input::now();
+        } else if (!isIdle) {
+            bool background = !hasFocus && !versus && !watching && !training;
+            pendingEvent = window.waitEvent(sf::milliseconds(background ? 1000 / BACKGROUND_FPS : SIM_TICK_MS));
+        }
+
         float dt = frameClock.restart().asSeconds();
         
-        while (auto eventOpt = window.pollEvent()) {
+        while (auto eventOpt = nextEvent()) {
             Event& event = *eventOpt;
+            needsRedraw = true;
 
             if (event.is<Event::Closed>()) {
-                window.close();
+                shouldClose = true;
+            }
+
+            if (event.is<Event::FocusLost>()) {
+                hasFocus = false;
+            }
+            if (event.is<Event::FocusGained>()) {
+                hasFocus = true;
             }
             
             if (auto* resized = event.getIf<Event::Resized>()) {
@@ -104,12 +296,17 @@ int main() {
                     {viewX / windowW, viewY / windowH},
                     {viewWidth / windowW, viewHeight / windowH}
                 ));
-                window.setView(gameView);
             }
             
             if (auto* key = event.getIf<Event::KeyPressed>()) {
+                if (key->code == Keyboard::Key::F3) {
+                    debugOverlay = !debugOverlay;
+                    AllocStats::setEnabled(debugOverlay);
+                }
                 if (key->code == Keyboard::Key::F11) {
                     isFullscreen = !isFullscreen;
+                    Render::stop();
+                    (void)window.setActive(true);
                     window.close();
                     
                     if (isFullscreen) {
@@ -134,31 +331,33 @@ int main() {
                         gameView.setViewport(sf::FloatRect({0.f, 0.f}, {1.f, 1.f}));
                     }
                     
-                    window.setFramerateLimit(60);
-                    window.setView(gameView);
+                    hasFocus = true;
+                    shownCursor = -1;
                     
                     if (icon.getSize().x > 0) {
                         window.setIcon(icon);
                     }
-                    timer.restart();
+                    (void)window.setActive(false);
+                    Render::start(window, font);
+                    gravityTimer = 0.f;
                 }
             }
 
             if (event.is<Event::MouseButtonPressed>()) {
                 Vector2i pixelPos = Mouse::getPosition(window);
-                Vector2f mousePos = window.mapPixelToCoords(pixelPos);
+                Vector2f mousePos = window.mapPixelToCoords(pixelPos, gameView);
 
                 if (state == GameState::MENU) {
                     UI::handleMenuClick(Vector2i(mousePos), state, previousState, shouldClose);
                     if (state == GameState::PLAYING) {
-                        timer.restart();
+                        gravityTimer = 0.f;
                     }
                 }
                 else if (state == GameState::PAUSED) {
                     if (mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW &&
                         mousePos.y >= 320 && mousePos.y <= 385) {
                         state = GameState::PLAYING;
-                        timer.restart();
+                        gravityTimer = 0.f;
                     }
                     if (mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW &&
                         mousePos.y >= 405 && mousePos.y <= 470) {
@@ -177,16 +376,21 @@ int main() {
                         state = GameState::MENU;
                     }
                 }
-                else if (state == GameState::PLAYING && isGameOver) {
+                else if (state == GameState::PLAYING && isGameOver && !watching) {
                     if (mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW &&
                         mousePos.y >= 340 && mousePos.y <= 405) {
                         saveHighScore();
-                        resetGame();
-                        timer.restart();
+                        if (versus) {
+                            Versus::requeue();
+                        } else {
+                            resetGame();
+                        }
+                        gravityTimer = 0.f;
                     }
                     if (mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW &&
                         mousePos.y >= 430 && mousePos.y <= 495) {
                         saveHighScore();
+                        if (versus) Versus::disconnect();
 /** Process restart */
                         Audio::playTheme();
                         state = GameState::MENU;
@@ -194,7 +398,7 @@ int main() {
                     if (mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW &&
                         mousePos.y >= 520 && mousePos.y <= 585) {
                         saveHighScore();
-                        window.close();
+                        shouldClose = true;
                     }
                 }
                 else if (state == GameState::SETTINGS) {
@@ -209,7 +413,7 @@ int main() {
                         saveSettings();
                         state = previousState;
                         if (previousState == GameState::PLAYING || previousState == GameState::PAUSED) {
-                            timer.restart();
+                            gravityTimer = 0.f;
                         }
                     }
                 }
@@ -219,273 +423,114 @@ int main() {
                 }
             }
 
-            if (state == GameState::PLAYING && !isGameOver) {
+            if (state == GameState::PLAYING && !isGameOver && !versus && !watching) {
                 if (auto* key = event.getIf<Event::KeyPressed>()) {
-                    if (!blockInput) {
-                        if (key->code == Keyboard::Key::Left) {
-                            if (canMove(-1, 0)) {
-                                x--;
-                                if (onGround) resetLockDelay();
-                            }
-                            leftHeld = true;
-                            dasTimer = 0.f;
-                            arrTimer = 0.f;
-                            lastMoveWasRotate = false;
-                        }
-                        if (key->code == Keyboard::Key::Right) {
-                            if (canMove(1, 0)) {
-                                x++;
-                                if (onGround) resetLockDelay();
-                            }
-                            rightHeld = true;
-                            dasTimer = 0.f;
-                            arrTimer = 0.f;
-                            lastMoveWasRotate = false;
-                        }
-                        if (key->code == Keyboard::Key::Down) {
-                            if (canMove(0, 1)) {
-                                y++;
-                                gScore += 1;
-                            }
-                            downHeld = true;
-                            dasTimer = 0.f;
-                            arrTimer = 0.f;
-                            lastMoveWasRotate = false;
-                        }
-                        if (key->code == Keyboard::Key::Up && currentPiece) {
-                            currentPiece->rotate(x, y);
-                            if (onGround) resetLockDelay();
-                            lastMoveWasRotate = true;
-                        }
-                        
-                        if (key->code == Keyboard::Key::Space) {
-                            int dropDist = getGhostY() - y;
-                            y = getGhostY();
-                            gScore += dropDist * 2;
-                            blockInput = true;
-                        }
-                    }
-                    
-                    if (key->code == Keyboard::Key::C) {
-                        swapHold();
-                        blockInput = false;
-                    }
-                    
                     if (key->code == Keyboard::Key::P || key->code == Keyboard::Key::Escape) {
                         state = GameState::PAUSED;
                     }
                 }
-                
-                if (auto* key = event.getIf<Event::KeyReleased>()) {
-                    if (key->code == Keyboard::Key::Left) leftHeld = false;
-                    if (key->code == Keyboard::Key::Right) rightHeld = false;
-                    if (key->code == Keyboard::Key::Down) downHeld = false;
-                }
             }
             else if (state == GameState::PAUSED) {
                 if (auto* key = event.getIf<Event::KeyPressed>()) {
                     if (key->code == Keyboard::Key::P || key->code == Keyboard::Key::Escape) {
                         state = GameState::PLAYING;
-                        timer.restart();
+                        gravityTimer = 0.f;
                     }
                 }
             }
-        }
-
-        if (state == GameState::PLAYING && !isGameOver) {
-            playTime += dt;
-            UI::updateLineClearAnim(dt);
-            UI::updateParticles(dt);
-            
-            if (!blockInput) {
-                if (leftHeld || rightHeld || downHeld) {
-                    dasTimer += dt;
-                    if (dasTimer >= DAS_DELAY) {
-                        arrTimer += dt;
-                        if (arrTimer >= ARR_DELAY) {
-                            if (leftHeld && canMove(-1, 0)) {
-                                x--;
-                                if (onGround) resetLockDelay();
-                                lastMoveWasRotate = false;
-                            }
-                            if (rightHeld && canMove(1, 0)) {
-                                x++;
-                                if (onGround) resetLockDelay();
-                                lastMoveWasRotate = false;
-                            }
-                            if (downHeld && canMove(0, 1)) {
-                                y++;
-                                gScore += 1;
-                                lastMoveWasRotate = false;
-                            }
-                            arrTimer = 0.f;
-                        }
-                    }
-                }
-            }
-            
-            bool canMoveDown = canMove(0, 1);
-            if (!canMoveDown) {
-                if (!onGround) {
-                    onGround = true;
-                    lockTimer = 0.f;
-                    lockMoves = 0;
-                }
-                lockTimer += dt;
-                
-                if (lockTimer >= LOCK_DELAY || lockMoves >= MAX_LOCK_MOVES) {
-                    blockInput = false;
-                    
-                    if (currentPiece) {
-                        for (int i = 0; i < 4; i++) {
-                            for (int j = 0; j < 4; j++) {
-                                if (currentPiece->shape[i][j] != ' ') {
-                                    sf::Color c = getColor(currentPiece->shape[i][j]);
-                                    UI::addParticles(fieldOffsetX + (x + j) * TILE_SIZE + TILE_SIZE/2,
-                                                    (y + i) * TILE_SIZE + TILE_SIZE/2, c, 3);
-                                }
-                            }
-                        }
-                    }
-                    
-                    block2Board();
-/** Transfer current piece to the game board */
-                    Audio::playLand();
-                    totalPieces++;
-                    
-                    if (currentPiece) {
-                        for (int i = 0; i < 4; i++) {
-                            for (int j = 0; j < 4; j++) {
-                                if (currentPiece->shape[i][j] != ' ') {
-                                    int idx = getPieceIndex(currentPiece->shape[i][j]);
-                                    if (idx >= 0) pieceCount[idx]++;
-                                    goto counted;
-                                }
-                            }
-                        }
-                        counted:;
-                    }
-                    
-                    int cleared = removeLine();
-                    applyLineClearScore(cleared);
-                    
-                    delete currentPiece;
-                    currentPiece = nextPiece;
-                    nextPiece = nextQueue[0];
-                    for (int i = 0; i < 3; i++) {
-                        nextQueue[i] = nextQueue[i + 1];
-                    }
-                    nextQueue[3] = createRandomPiece();
-                    
-                    x = 4;
-                    y = 0;
-                    canHold = true;
-                    onGround = false;
-                    lockTimer = 0.f;
-                    lockMoves = 0;
-                    
-                    if (!canMove(0, 0)) {
-                        isGameOver = true;
-                        saveHighScore();
-                        Audio::stopTheme();
-                        Audio::playGameOver();
+            else if (state == GameState::PLAYING && isGameOver && gameMode == GameMode::PRACTICE) {
+                if (auto* key = event.getIf<Event::KeyPressed>()) {
+                    if (key->code == Keyboard::Key::Z && Practice::undo()) {
+                        Audio::playTheme();
+                        simTime = Input::now();
                     }
                 }
-            } else {
-                onGround = false;
-                lockTimer = 0.f;
-            }
-            
-            if (timer.getElapsedTime().asSeconds() >= gameDelay) {
-                if (canMoveDown) {
-                    y++;
-                }
-                timer.restart();
             }
         }
 
-        window.clear(Color::Black);
+        // Gameplay keys come from the input sampler with their own timestamps;
+        // the simulation is advanced up to each one before it is applied.
+        bool gameActive = state == GameState::PLAYING && !isGameOver && !watching && !training &&
+                          (!versus || Versus::phase() == Versus::Phase::PLAYING);
+        Input::setActive(gameActive && hasFocus);
+        double now = Input::now();
+        Input::KeyEvent keyEvent;
 
-        if (state == GameState::MENU) {
-/** Process clear */
-            UI::drawMenu(window, font);
-        }
-        else if (state == GameState::PLAYING || state == GameState::PAUSED) {
-            UI::drawPieceStats(window, font);
-            
-            for (int i = 0; i < H; i++) {
-                for (int j = 0; j < W; j++) {
-                    UI::drawTile3D(window, fieldOffsetX + (float)(j * TILE_SIZE), (float)(i * TILE_SIZE), 
-                                   TILE_SIZE, board[i][j]);
+        if (versus) {
+            // Versus runs in fixed ticks, so keys become a held bitmask;
+            // a tap shorter than one tick still counts for that tick.
+            while (Input::poll(keyEvent)) {
+                std::uint8_t bit = static_cast<std::uint8_t>(1 << static_cast<int>(keyEvent.key));
+                if (keyEvent.pressed) {
+                    heldKeys |= bit;
+                    tappedKeys |= bit;
+                } else {
+                    heldKeys &= ~bit;
                 }
             }
-
-            if (currentPiece && ghostPieceEnabled && state == GameState::PLAYING) {
-                int ghostY = getGhostY();
-                for (int i = 0; i < 4; i++) {
-                    for (int j = 0; j < 4; j++) {
-                        if (currentPiece->shape[i][j] != ' ') {
-                            RectangleShape ghost({TILE_SIZE - 1.f, TILE_SIZE - 1.f});
-                            ghost.setPosition({fieldOffsetX + (float)((x + j) * TILE_SIZE), (float)((ghostY + i) * TILE_SIZE)});
-                            Color c = getColor(currentPiece->shape[i][j]);
-                            c.a = 60;
-                            ghost.setFillColor(c);
-                            ghost.setOutlineThickness(1.f);
-                            ghost.setOutlineColor(Color(c.r, c.g, c.b, 120));
-                            window.draw(ghost);
-                        }
-                    }
+            if (!gameActive || !hasFocus) heldKeys = tappedKeys = 0;
+            if (Versus::update(dt, heldKeys | tappedKeys) > 0) tappedKeys = 0;
+            needsRedraw = true;
+        } else if (watching) {
+            // A spectator only mirrors the broadcaster's field.
+            while (Input::poll(keyEvent)) {}
+            if (!Spectate::pollViewer()) state = GameState::MENU;
+            needsRedraw = true;
+        } else if (training) {
+            while (Input::poll(keyEvent)) {}
+            if (!Training::update(dt, state)) shouldClose = true;
+            needsRedraw = true;
+        } else if (gameActive) {
+            needsRedraw = true;
+            while (Input::poll(keyEvent)) {
+                if (keyEvent.time > simTime) {
+                    advanceGame(static_cast<float>(keyEvent.time - simTime));
+                    simTime = keyEvent.time;
                 }
+                onGameKey(keyEvent.key, keyEvent.pressed);
             }
-
-            if (currentPiece) {
-                UI::drawSoftDropTrail(window, currentPiece, x, y, downHeld && canMove(0, 1));
-                
-                for (int i = 0; i < 4; i++) {
-                    for (int j = 0; j < 4; j++) {
-                        if (currentPiece->shape[i][j] != ' ') {
-/** Render softdroptrail */
-                            UI::drawTile3D(window, fieldOffsetX + (float)((x + j) * TILE_SIZE), 
-                                          (float)((y + i) * TILE_SIZE), 
-                                          TILE_SIZE, currentPiece->shape[i][j]);
-                        }
-                    }
-                }
-            }
-
-/** Render particles */
-            UI::drawParticles(window);
-            
-/** Render particles */
-            UI::drawLineClearAnim(window);
-            
-/** Render particles */
-            UI::drawCombo(window, font);
-
-/** Render lineclearanim */
-            UI::drawSidebar(window, sidebarUI, font, gScore, gLevel, gLines, nextPiece, nextQueue, holdPiece);
-
-            if (isGameOver) {
-/** Render combo */
-                UI::drawGameOverScreen(window, font);
-            }
-            
-            if (state == GameState::PAUSED) {
-                UI::drawPauseScreen(window, font);
+            // After a background wait, catch up in SIM_TICK_MS steps so
+            // gravity and lock timing run as they do in the focused loop.
+            const double step = SIM_TICK_MS / 1000.0;
+            for (; now - simTime > step; simTime += step) {
+                advanceGame(static_cast<float>(step));
             }
+            advanceGame(static_cast<float>(now - simTime));
+        } else {
+            while (Input::poll(keyEvent)) {}
+            leftHeld = rightHeld = downHeld = false;
+            Practice::setRewinding(false);
         }
-        else if (state == GameState::SETTINGS) {
-            UI::drawSettingsScreen(window, font);
-        }
-        else if (state == GameState::HOWTOPLAY) {
-            UI::drawHowToPlay(window, font);
+        simTime = now;
+        if (state == GameState::PLAYING && !watching) {
+            AllocStats::Scope netScope(AllocStats::Subsystem::NET);
+            Spectate::publish();
         }
 
-        UI::drawBrightnessOverlay(window);
+        if (!needsRedraw) continue;
+
+        Render::Frame& frame = Render::frame();
+        frame.state = state;
+        frame.live = versus || watching || training || (state == GameState::PLAYING && !isGameOver);
+        frame.focused = hasFocus || training;
+        frame.debugOverlay = debugOverlay;
+        frame.versus = versus;
+        frame.versusWaiting = versus && Versus::phase() == Versus::Phase::WAITING;
+        frame.desynced = Versus::desynced();
+        frame.watching = watching;
+        frame.replay = false;
+        frame.versusResult = Versus::result();
+        frame.rankedGames = Leaderboard::table(difficulty, gameMode).games;
+        frame.practiceDepth = Practice::depth();
+        saveSnapshot(frame.game);
+        if (versus) frame.opponent = Versus::opponent();
+        saveSettingsSnapshot(frame.settings);
+        frame.view = gameView;
+        Render::publish(now);
 
         bool onButton = false;
         Vector2i pixelPos = Mouse::getPosition(window);
-        Vector2f mousePos = window.mapPixelToCoords(pixelPos);
+        Vector2f mousePos = window.mapPixelToCoords(pixelPos, gameView);
         
         if (state == GameState::MENU) {
             const float btnW = 280.f;
@@ -530,6 +575,7 @@ int main() {
             const float dasSliderY = 413.f;
             const float arrSliderY = 498.f;
             const float row6Y = 565.f;
+            const float row7Y = 630.f;
             
             bool onArrow = (mousePos.x >= arrowLeftX && mousePos.x <= arrowLeftX + 30 && mousePos.y >= row1Y - 10 && mousePos.y <= row1Y + 40) ||
                            (mousePos.x >= arrowRightX && mousePos.x <= arrowRightX + 30 && mousePos.y >= row1Y - 10 && mousePos.y <= row1Y + 40) ||
@@ -546,7 +592,8 @@ int main() {
                             (mousePos.x >= sliderX && mousePos.x <= sliderX + sliderW && mousePos.y >= row3Y && mousePos.y <= row3Y + 35) ||
                             (mousePos.x >= sliderX && mousePos.x <= sliderX + sliderW && mousePos.y >= dasSliderY && mousePos.y <= dasSliderY + 35) ||
                             (mousePos.x >= sliderX && mousePos.x <= sliderX + sliderW && mousePos.y >= arrSliderY && mousePos.y <= arrSliderY + 35);
-            bool onCheckbox = (mousePos.x >= checkboxX && mousePos.x <= checkboxX + 35 && mousePos.y >= row6Y - 5 && mousePos.y <= row6Y + 40);
+            bool onCheckbox = (mousePos.x >= checkboxX && mousePos.x <= checkboxX + 35 && mousePos.y >= row6Y - 5 && mousePos.y <= row6Y + 40) ||
+                              (mousePos.x >= checkboxX && mousePos.x <= checkboxX + 35 && mousePos.y >= row7Y - 5 && mousePos.y <= row7Y + 40);
             bool onBackBtn = (mousePos.x >= backBtnX && mousePos.x <= backBtnX + backBtnW &&
                               mousePos.y >= 700 && mousePos.y <= 765);
             if (onArrow || onSlider || onCheckbox || onBackBtn) {
@@ -561,7 +608,7 @@ int main() {
                 onButton = true;
             }
         }
-        else if (state == GameState::PLAYING && isGameOver) {
+        else if (state == GameState::PLAYING && isGameOver && !watching) {
             if ((mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW && mousePos.y >= 340 && mousePos.y <= 405) ||
                 (mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW && mousePos.y >= 430 && mousePos.y <= 495) ||
                 (mousePos.x >= goBtnX && mousePos.x <= goBtnX + goBtnW && mousePos.y >= 520 && mousePos.y <= 585)) {
@@ -569,13 +616,30 @@ int main() {
             }
         }
         
-        window.setMouseCursor(onButton ? Cursor(Cursor::Type::Hand) : Cursor(Cursor::Type::Arrow));
+        if (shownCursor != (onButton ? 1 : 0)) {
+            shownCursor = onButton ? 1 : 0;
+            window.setMouseCursor(onButton ? handCursor : arrowCursor);
+        }
+        needsRedraw = false;
 
-        window.display();
+        if (!startupReported) {
+            startupReported = true;
+            std::printf("Startup: first frame %.1f ms, interactive %.1f ms\n",
+                        firstFrameMs, startupClock.getElapsedTime().asSeconds() * 1000.f);
+        }
     }
 
+    Render::stop();
+    Training::finish();
+    Input::stop();
+    Versus::disconnect();
+    Spectate::stopWatching();
+    Spectate::stopServer();
     saveHighScore();
     saveSettings();
+    Telemetry::endSession();
+    Persist::stop();
+    Jobs::stop();
 /** Process display */
     Audio::cleanup();
     delete currentPiece;
@@ -584,6 +648,7 @@ int main() {
         if (nextQueue[i]) delete nextQueue[i];
     }
     if (holdPiece) delete holdPiece;
+    Assets::close();
 
-    return 0;
+    return trainingFailed ? 1 : 0;
 }
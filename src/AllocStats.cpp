@@ -0,0 +1,99 @@
+/*
+ * Tetris Game - Heap allocation accounting implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "AllocStats.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace AllocStats {
+
+    struct alignas(64) Counter {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    static Counter counters[SUBSYSTEM_COUNT];
+    static std::atomic<bool> tracking{false};
+    thread_local Subsystem current = Subsystem::OTHER;
+
+    static const char* const names[SUBSYSTEM_COUNT] = {"other", "sim", "render", "net", "io", "jobs", "debug"};
+
+    static void record(std::size_t size) {
+        if (!tracking.load(std::memory_order_relaxed)) return;
+        Counter& counter = counters[static_cast<int>(current)];
+        counter.calls.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled) {
+        tracking.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool enabled() {
+        return tracking.load(std::memory_order_relaxed);
+    }
+
+/** Running totals since startup; counts only grow while tracking is enabled */
+    Totals totals() {
+        Totals result;
+        for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+            result.subsystems[i].calls = counters[i].calls.load(std::memory_order_relaxed);
+            result.subsystems[i].bytes = counters[i].bytes.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    Totals difference(const Totals& later, const Totals& earlier) {
+        Totals result;
+        for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+            result.subsystems[i].calls = later.subsystems[i].calls - earlier.subsystems[i].calls;
+            result.subsystems[i].bytes = later.subsystems[i].bytes - earlier.subsystems[i].bytes;
+        }
+        return result;
+    }
+
+    Counts sum(const Totals& totals) {
+        Counts result = {0, 0};
+        for (const Counts& counts : totals.subsystems) {
+            result.calls += counts.calls;
+            result.bytes += counts.bytes;
+        }
+        return result;
+    }
+
+    const char* name(int subsystem) {
+        return subsystem >= 0 && subsystem < SUBSYSTEM_COUNT ? names[subsystem] : "?";
+    }
+
+    Scope::Scope(Subsystem subsystem) : previous(current) {
+        current = subsystem;
+    }
+
+    Scope::~Scope() {
+        current = previous;
+    }
+}
+
+// The array forms and the nothrow forms forward to these by default.
+void* operator new(std::size_t size) {
+    AllocStats::record(size);
+    if (size == 0) size = 1;
+    for (;;) {
+        if (void* block = std::malloc(size)) return block;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
@@ -0,0 +1,57 @@
+/*
+ * Tetris Game - Heap allocation accounting
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstdint>
+
+// Opt-in heap accounting. The global operator new is replaced to count
+// calls and bytes while tracking is enabled; when it is off the only cost
+// is one relaxed load per allocation. Each thread charges its allocations
+// to the subsystem of its innermost Scope (OTHER outside any). Direct
+// malloc calls and over-aligned new are not counted.
+namespace AllocStats {
+    enum class Subsystem {
+        OTHER,
+        SIM,
+        RENDER,
+        NET,
+        IO,
+        JOBS,
+        DEBUG,
+        COUNT
+    };
+
+    const int SUBSYSTEM_COUNT = static_cast<int>(Subsystem::COUNT);
+
+    struct Counts {
+        std::uint64_t calls;
+        std::uint64_t bytes;
+    };
+
+    struct Totals {
+        Counts subsystems[SUBSYSTEM_COUNT];
+    };
+
+    void setEnabled(bool enabled);
+    bool enabled();
+
+    Totals totals();
+    Totals difference(const Totals& later, const Totals& earlier);
+    Counts sum(const Totals& totals);
+    const char* name(int subsystem);
+
+    /** Charge the calling thread's allocations to subsystem until destroyed */
+    class Scope {
+    public:
+        explicit Scope(Subsystem subsystem);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Subsystem previous;
+    };
+}
@@ -0,0 +1,188 @@
+/*
+ * Tetris Game - Memory-mapped asset pack implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "AssetPack.h"
+#include "PackFormat.h"
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach-o/dyld.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Assets {
+
+    static const char* mapped = nullptr;
+    static std::size_t mappedSize = 0;
+    static const PackEntry* entries = nullptr;
+    static std::uint32_t entryCount = 0;
+    static std::string baseDir;
+
+#ifdef _WIN32
+    static HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    static HANDLE mappingHandle = nullptr;
+#endif
+
+/** Directory holding the running executable, with a trailing separator */
+    static std::string executableDir() {
+        char buf[4096] = {};
+#ifdef _WIN32
+        DWORD len = GetModuleFileNameA(nullptr, buf, sizeof(buf) - 1);
+        if (len == 0) return "";
+#elif defined(__APPLE__)
+        uint32_t len = sizeof(buf) - 1;
+        if (_NSGetExecutablePath(buf, &len) != 0) return "";
+#else
+        ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+        if (len <= 0) return "";
+        buf[len] = '\0';
+#endif
+        std::string exe(buf);
+        std::size_t slash = exe.find_last_of("/\\");
+        return (slash == std::string::npos) ? "" : exe.substr(0, slash + 1);
+    }
+
+/** Map a whole file read-only, returns nullptr on failure */
+    static const char* mapFile(const std::string& file, std::size_t& size) {
+#ifdef _WIN32
+        fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return nullptr;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) return nullptr;
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle) return nullptr;
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+        return static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+        int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0) return nullptr;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        void* addr = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) return nullptr;
+        size = static_cast<std::size_t>(st.st_size);
+        return static_cast<const char*>(addr);
+#endif
+    }
+
+/** Map assets.pak and validate its index */
+    bool open() {
+        if (mapped) return true;
+        baseDir = executableDir();
+
+        std::size_t size = 0;
+        const char* data = mapFile(baseDir + "assets.pak", size);
+        if (!data) {
+            close();
+            return false;
+        }
+        mapped = data;
+        mappedSize = size;
+
+        const PackHeader* header = reinterpret_cast<const PackHeader*>(mapped);
+        if (mappedSize < sizeof(PackHeader) ||
+            std::memcmp(header->magic, PACK_MAGIC, 4) != 0 ||
+            header->version != PACK_VERSION ||
+            mappedSize < sizeof(PackHeader) + header->count * sizeof(PackEntry)) {
+            close();
+            return false;
+        }
+
+        entries = reinterpret_cast<const PackEntry*>(mapped + sizeof(PackHeader));
+        entryCount = header->count;
+        for (std::uint32_t i = 0; i < entryCount; i++) {
+            if (entries[i].offset + entries[i].size > mappedSize) {
+                close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+/** Unmap the pack */
+    void close() {
+#ifdef _WIN32
+        if (mapped) UnmapViewOfFile(mapped);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (mapped) munmap(const_cast<char*>(mapped), mappedSize);
+#endif
+        mapped = nullptr;
+        mappedSize = 0;
+        entries = nullptr;
+        entryCount = 0;
+    }
+
+/** Binary-search the sorted index for name */
+    bool find(const char* name, const void*& data, std::size_t& size) {
+        int lo = 0;
+        int hi = static_cast<int>(entryCount) - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            int cmp = std::strncmp(name, entries[mid].name, PACK_NAME_LEN);
+            if (cmp == 0) {
+                data = mapped + entries[mid].offset;
+                size = static_cast<std::size_t>(entries[mid].size);
+                return true;
+            }
+            if (cmp < 0) hi = mid - 1;
+            else lo = mid + 1;
+        }
+        return false;
+    }
+
+/** Loose-file fallback path for name */
+    std::string path(const char* name) {
+        return baseDir + "assets/" + name;
+    }
+
+    bool loadFont(sf::Font& font, const char* name) {
+        const void* data;
+        std::size_t size;
+        if (find(name, data, size)) return font.openFromMemory(data, size);
+        return font.openFromFile(path(name));
+    }
+
+    bool loadImage(sf::Image& image, const char* name) {
+        const void* data;
+        std::size_t size;
+        if (find(name, data, size)) return image.loadFromMemory(data, size);
+        return image.loadFromFile(path(name));
+    }
+
+    bool loadSound(sf::SoundBuffer& buffer, const char* name) {
+        const void* data;
+        std::size_t size;
+        if (find(name, data, size)) return buffer.loadFromMemory(data, size);
+        return buffer.loadFromFile(path(name));
+    }
+
+    bool openMusic(sf::Music& music, const char* name) {
+        const void* data;
+        std::size_t size;
+        if (find(name, data, size)) return music.openFromMemory(data, size);
+        return music.openFromFile(path(name));
+    }
+}
@@ -0,0 +1,26 @@
+/*
+ * Tetris Game - Memory-mapped asset pack
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string>
+
+// Assets are looked up in assets.pak next to the executable. When the pack
+// is missing they fall back to loose files under <exe dir>/assets/.
+namespace Assets {
+    bool open();
+    void close();
+
+    bool find(const char* name, const void*& data, std::size_t& size);
+    std::string path(const char* name);
+
+    bool loadFont(sf::Font& font, const char* name);
+    bool loadImage(sf::Image& image, const char* name);
+    bool loadSound(sf::SoundBuffer& buffer, const char* name);
+    bool openMusic(sf::Music& music, const char* name);
+}
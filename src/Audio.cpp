@@ -6,131 +6,200 @@
 
 #include "Audio.h"
 #include "Game.h"
+#include "AssetPack.h"
+#include "Jobs.h"
 
 namespace Audio {
 
-    static sf::SoundBuffer clearBuffer;
-    static sf::SoundBuffer landBuffer;
-    static sf::SoundBuffer gameOverBuffer;
-    static sf::SoundBuffer settingClickBuffer;
-
-    static sf::SoundBuffer startGameBuffer;
-    static sf::SoundBuffer levelUpBuffer;
-    static sf::SoundBuffer openSettingsBuffer;
-    static sf::SoundBuffer closeSettingsBuffer;
-    static sf::SoundBuffer toggleOnBuffer;
-    static sf::SoundBuffer toggleOffBuffer;
-
-    static sf::Sound* clearSound = nullptr;
-    static sf::Sound* landSound = nullptr;
-    static sf::Sound* gameOverSound = nullptr;
-    static sf::Sound* settingClickSound = nullptr;
-
-    static sf::Sound* startGameSound = nullptr;
-    static sf::Sound* levelUpSound = nullptr;
-    static sf::Sound* openSettingsSound = nullptr;
-    static sf::Sound* closeSettingsSound = nullptr;
-    static sf::Sound* toggleOnSound = nullptr;
-    static sf::Sound* toggleOffSound = nullptr;
+    enum Effect {
+        SFX_CLEAR,
+        SFX_LAND,
+        SFX_GAME_OVER,
+        SFX_SETTING_CLICK,
+        SFX_START_GAME,
+        SFX_LEVEL_UP,
+        SFX_OPEN_SETTINGS,
+        SFX_CLOSE_SETTINGS,
+        SFX_TOGGLE_ON,
+        SFX_TOGGLE_OFF,
+        SFX_COUNT
+    };
+
+    struct EffectInfo {
+        const char* path;
+        int maxVoices;
+        bool required;
+        bool lazy;
+    };
+
+    // Lazy effects only belong to the settings screens, so they are decoded
+    // on first use instead of at startup.
+    static const EffectInfo effects[SFX_COUNT] = {
+        {"audio/line_clear.ogg",      4, true,  false},
+        {"audio/bumper_end.ogg",      3, true,  false},
+        {"audio/game_over.ogg",       1, true,  false},
+        {"audio/insetting_click.ogg", 2, false, true},
+        {"audio/start_game.ogg",      1, false, false},
+        {"audio/level_up.ogg",        1, false, false},
+        {"audio/open_settings.ogg",   1, false, true},
+        {"audio/close_settings.ogg",  1, false, true},
+        {"audio/toggle_on.ogg",       1, false, true},
+        {"audio/toggle_off.ogg",      1, false, true},
+    };
+
+    // Fixed pool of voices shared by all effects. Each effect may hold at
+    // most maxVoices of them; past that its oldest voice is restarted.
+    static const int VOICE_COUNT = 12;
+
+    struct Voice {
+        sf::Sound* sound = nullptr;
+        int effect = -1;
+        unsigned startedAt = 0;
+    };
+
+    static sf::SoundBuffer buffers[SFX_COUNT];
+    static bool decoded[SFX_COUNT] = {};
+    static Voice voices[VOICE_COUNT];
+    static unsigned playCounter = 0;
+    static float sfxBusGain = 100.f;
 
     static sf::Music bgMusic;
 
 /** Initialize  */
     bool init() {
 
-        if (!bgMusic.openFromFile("assets/audio/loop_theme.ogg")) return false;
-        if (!clearBuffer.loadFromFile("assets/audio/line_clear.ogg")) return false;
-        if (!landBuffer.loadFromFile("assets/audio/bumper_end.ogg")) return false;
-        if (!gameOverBuffer.loadFromFile("assets/audio/game_over.ogg")) return false;
-        if (!settingClickBuffer.loadFromFile("assets/audio/insetting_click.ogg")) return false;
-
-        (void)startGameBuffer.loadFromFile("assets/audio/start_game.ogg");
-        (void)levelUpBuffer.loadFromFile("assets/audio/level_up.ogg");
-        (void)openSettingsBuffer.loadFromFile("assets/audio/open_settings.ogg");
-        (void)closeSettingsBuffer.loadFromFile("assets/audio/close_settings.ogg");
-        (void)toggleOnBuffer.loadFromFile("assets/audio/toggle_on.ogg");
-        (void)toggleOffBuffer.loadFromFile("assets/audio/toggle_off.ogg");
-
-        clearSound = new sf::Sound(clearBuffer);
-        landSound = new sf::Sound(landBuffer);
-        gameOverSound = new sf::Sound(gameOverBuffer);
-        settingClickSound = new sf::Sound(settingClickBuffer);
-
-        startGameSound = new sf::Sound(startGameBuffer);
-        levelUpSound = new sf::Sound(levelUpBuffer);
-        openSettingsSound = new sf::Sound(openSettingsBuffer);
-        closeSettingsSound = new sf::Sound(closeSettingsBuffer);
-        toggleOnSound = new sf::Sound(toggleOnBuffer);
-        toggleOffSound = new sf::Sound(toggleOffBuffer);
+        Jobs::Group decodes;
+        bool loadedOk[SFX_COUNT] = {};
+        for (int i = 0; i < SFX_COUNT; i++) {
+            if (effects[i].lazy) continue;
+            Jobs::run(decodes, [i, &loadedOk] {
+                loadedOk[i] = Assets::loadSound(buffers[i], effects[i].path);
+            });
+        }
+
+        bool ok = Assets::openMusic(bgMusic, "audio/loop_theme.ogg");
+
+        Jobs::wait(decodes);
+        for (int i = 0; i < SFX_COUNT; i++) {
+            if (effects[i].lazy) continue;
+            decoded[i] = true;
+            if (!loadedOk[i] && effects[i].required) ok = false;
+        }
+        if (!ok) return false;
+
+        for (Voice& voice : voices) {
+            voice.sound = new sf::Sound(buffers[SFX_CLEAR]);
+        }
 
         bgMusic.setLooping(true);
         bgMusic.setVolume(musicVolume);
+        sfxBusGain = sfxVolume;
 
         return true;
     }
 
-/** Set volume level for audio */
+/** Stop everything and release the music stream; call before Assets::close unmaps the pack it reads */
     void cleanup() {
-        delete clearSound;
-        delete landSound;
-        delete gameOverSound;
-        delete settingClickSound;
-        delete startGameSound;
-        delete levelUpSound;
-        delete openSettingsSound;
-        delete closeSettingsSound;
-        delete toggleOnSound;
-        delete toggleOffSound;
+        for (Voice& voice : voices) {
+            delete voice.sound;
+            voice.sound = nullptr;
+        }
+        bgMusic.stop();
+        bgMusic = sf::Music();
+    }
+
+/** Start an effect on a free voice, stealing the oldest one if needed */
+    static void play(int effect) {
+        if (!voices[0].sound) return;
+
+        if (!decoded[effect]) {
+            decoded[effect] = true;
+            (void)Assets::loadSound(buffers[effect], effects[effect].path);
+        }
+
+        int sameCount = 0;
+        int oldestSame = -1;
+        int oldestAny = 0;
+        int freeVoice = -1;
+
+        for (int i = 0; i < VOICE_COUNT; i++) {
+            if (voices[i].sound->getStatus() != sf::SoundSource::Status::Playing) {
+                if (freeVoice < 0) freeVoice = i;
+                continue;
+            }
+            if (voices[i].effect == effect) {
+                sameCount++;
+                if (oldestSame < 0 || voices[i].startedAt < voices[oldestSame].startedAt) oldestSame = i;
+            }
+            if (voices[i].startedAt < voices[oldestAny].startedAt) oldestAny = i;
+        }
+
+        int target;
+        if (sameCount >= effects[effect].maxVoices) {
+            target = oldestSame;
+        } else if (freeVoice >= 0) {
+            target = freeVoice;
+        } else {
+            target = oldestAny;
+        }
+
+        Voice& voice = voices[target];
+        voice.sound->stop();
+        voice.sound->setBuffer(buffers[effect]);
+        voice.sound->setVolume(sfxBusGain);
+        voice.sound->play();
+        voice.effect = effect;
+        voice.startedAt = ++playCounter;
     }
 
 /** Process playClear */
     void playClear() {
-        if (clearSound) clearSound->play();
+        play(SFX_CLEAR);
     }
 
 /** Process playClear */
     void playLand() {
-        if (landSound) landSound->play();
+        play(SFX_LAND);
     }
 
 /** Process playLand */
     void playGameOver() {
-        if (gameOverSound) gameOverSound->play();
+        play(SFX_GAME_OVER);
     }
 
 /** Process playGameOver */
     void playSettingClick() {
-        if (settingClickSound) settingClickSound->play();
+        play(SFX_SETTING_CLICK);
     }
 
 /** Process playSettingClick */
     void playStartGame() {
-        if (startGameSound) startGameSound->play();
+        play(SFX_START_GAME);
     }
 
 /** Process playStartGame */
     void playLevelUp() {
-        if (levelUpSound) levelUpSound->play();
+        play(SFX_LEVEL_UP);
     }
 
 /** Process playLevelUp */
     void playOpenSettings() {
-        if (openSettingsSound) openSettingsSound->play();
+        play(SFX_OPEN_SETTINGS);
     }
 
 /** Process playOpenSettings */
     void playCloseSettings() {
-        if (closeSettingsSound) closeSettingsSound->play();
+        play(SFX_CLOSE_SETTINGS);
     }
 
 /** Process playCloseSettings */
     void playToggleOn() {
-        if (toggleOnSound) toggleOnSound->play();
+        play(SFX_TOGGLE_ON);
     }
 
 /** Process playToggleOn */
     void playToggleOff() {
-        if (toggleOffSound) toggleOffSound->play();
+        play(SFX_TOGGLE_OFF);
     }
 
 /** Process playToggleOff */
@@ -160,16 +229,12 @@ namespace Audio {
 
 /** Process setMusicVolume */
     void setSfxVolume(float volume) {
-        if (clearSound) clearSound->setVolume(volume);
-        if (landSound) landSound->setVolume(volume);
-        if (gameOverSound) gameOverSound->setVolume(volume);
-        if (settingClickSound) settingClickSound->setVolume(volume);
-        if (startGameSound) startGameSound->setVolume(volume);
-        if (levelUpSound) levelUpSound->setVolume(volume);
-        if (openSettingsSound) openSettingsSound->setVolume(volume);
-        if (closeSettingsSound) closeSettingsSound->setVolume(volume);
-        if (toggleOnSound) toggleOnSound->setVolume(volume);
-        if (toggleOffSound) toggleOffSound->setVolume(volume);
+        sfxBusGain = volume;
+        for (Voice& voice : voices) {
+            if (voice.sound && voice.sound->getStatus() == sf::SoundSource::Status::Playing) {
+                voice.sound->setVolume(sfxBusGain);
+            }
+        }
     }
 
     sf::Music& getMusic() {
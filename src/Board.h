@@ -0,0 +1,92 @@
+/*
+ * Tetris Game - Compile-time board geometry
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+#include <cstdint>
+#include <type_traits>
+
+// A playfield interior (walls and floor excluded) as one bit mask per row,
+// top row first, bit c set when column c is filled. Width and height are
+// template parameters, so every loop bound and mask below is a constant:
+// the compiler unrolls the kernels and each geometry gets its own code
+// with no runtime size checks. Row is the smallest word that still holds a
+// row with a wall bit on each side, as the transition kernels need; Word
+// is the type masks are computed in (at least 32 bits, no int promotion).
+template <int Cols, int Height>
+struct Board {
+    static_assert(Cols >= 4 && Cols + 2 <= 64, "a row and its two walls must fit in 64 bits");
+    static_assert(Height >= 4, "a piece must fit below the spawn row");
+
+    using Row = typename std::conditional<Cols + 2 <= 16, std::uint16_t,
+                typename std::conditional<Cols + 2 <= 32, std::uint32_t, std::uint64_t>::type>::type;
+    using Word = typename std::conditional<sizeof(Row) <= 4, std::uint32_t, std::uint64_t>::type;
+
+    static constexpr int COLS = Cols;
+    static constexpr int ROWS = Height;
+    static constexpr Row FULL_ROW = static_cast<Row>((Word(1) << Cols) - 1);
+    static constexpr Word EDGE_COLUMNS = Word(1) | Word(1) << (Cols - 1);
+
+    Row bits[Height];
+
+    /** Row index of the highest filled cell per column, ROWS when empty */
+    void columnTops(int (&tops)[Cols]) const {
+        Word pending = FULL_ROW;
+        for (int c = 0; c < Cols; c++) tops[c] = Height;
+        for (int r = 0; r < Height && pending; r++) {
+            Word hit = bits[r] & pending;
+            pending &= ~hit;
+            for (; hit; hit &= hit - 1) tops[lowestBit(hit)] = r;
+        }
+    }
+
+    /** Row mask of a 4-wide shape row whose box starts at interior column; false if it leaves the board */
+    static bool placeRow(Word shapeBits, int column, Row& mask) {
+        Word placed;
+        if (column < 0) {
+            if (shapeBits & ((Word(1) << -column) - 1)) return false;
+            placed = shapeBits >> -column;
+        } else {
+            placed = shapeBits << column;
+        }
+        mask = static_cast<Row>(placed);
+        return (placed & ~static_cast<Word>(FULL_ROW)) == 0;
+    }
+
+    /** Whether the shape rows fit with their box's top-left at (column, row) */
+    bool fits(const std::uint8_t (&shapeRows)[4], int column, int row) const {
+        for (int i = 0; i < 4; i++) {
+            if (!shapeRows[i]) continue;
+            Row mask;
+            if (!placeRow(shapeRows[i], column, mask) || row + i >= Height) return false;
+            if (bits[row + i] & mask) return false;
+        }
+        return true;
+    }
+
+    /** Drop full rows and shift the ones above down; like removeLine, the top row stays */
+    int clearFullRows() {
+        int write = Height - 1;
+        for (int r = Height - 1; r > 0; r--) {
+            if (bits[r] != FULL_ROW) bits[write--] = bits[r];
+        }
+        int cleared = write;
+        for (; write > 0; write--) bits[write] = 0;
+        return cleared;
+    }
+
+    static int lowestBit(Word bits) {
+        return sizeof(Word) <= 4 ? __builtin_ctz(static_cast<std::uint32_t>(bits))
+                                 : __builtin_ctzll(static_cast<unsigned long long>(bits));
+    }
+};
+
+// The live game's playfield, and the variant geometries the kernels are
+// built for: the guideline 10x40 field (20 visible rows under a 20-row
+// hidden buffer) and a 16-wide field whose rows need 32-bit words.
+using StandardBoard = Board<W - 2, H - 1>;
+using GuidelineBoard = Board<10, 40>;
+using WideBoard = Board<16, 24>;
@@ -0,0 +1,292 @@
+/*
+ * Tetris Game - Heuristic placement bot implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Bot.h"
+#include "Game.h"
+#include "TransTable.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Bot {
+
+    using Features::COLS;
+    using Features::FULL_ROW;
+    using Features::ROWS;
+    using Features::Rows;
+
+    static const int SPAWN_X = 4;
+    static const std::int32_t LOSS = -(1 << 30);
+
+    // Every rotation of a piece type as the engine produces it from spawn:
+    // the 4x4 shape (to recognise a held piece's kept rotation), one
+    // 4-bit mask per shape row and the lowest filled row per shape column.
+    struct Rotation {
+        char shape[4][4];
+        std::uint8_t rowBits[4];
+        std::int8_t bottom[4];
+    };
+
+    struct PieceShapes {
+        Rotation rotations[4];
+        int count;
+    };
+
+    static PieceShapes shapes[7];
+
+    struct Evaluator {
+        std::int32_t weights[Features::FEATURE_COUNT];
+        std::uint64_t salt;
+    };
+
+    struct Placement {
+        int rotation;
+        int column;
+    };
+
+    Weights defaultWeights() {
+        Weights w = {{-0.30f, -0.10f, -0.15f, -0.80f, -0.50f, -0.10f, -0.30f, -0.90f, -0.30f, 0.20f}};
+        return w;
+    }
+
+/** Record each piece's rotations by spinning fresh pieces at spawn on an empty board */
+    void init() {
+        initBoard();
+        int savedX = x;
+        for (int type = 0; type < 7; type++) {
+            PieceShapes& piece = shapes[type];
+            Piece* scratch = createPiece(type);
+            piece.count = 0;
+            for (int r = 0; r < 4; r++) {
+                if (r > 0 && std::memcmp(scratch->shape, piece.rotations[0].shape, sizeof(scratch->shape)) == 0) break;
+                Rotation& rot = piece.rotations[piece.count++];
+                std::memcpy(rot.shape, scratch->shape, sizeof(rot.shape));
+                for (int i = 0; i < 4; i++) {
+                    rot.rowBits[i] = 0;
+                    rot.bottom[i] = -1;
+                }
+                for (int i = 0; i < 4; i++) {
+                    for (int j = 0; j < 4; j++) {
+                        if (rot.shape[i][j] == ' ') continue;
+                        rot.rowBits[i] |= 1u << j;
+                        rot.bottom[j] = static_cast<std::int8_t>(i);
+                    }
+                }
+                x = SPAWN_X;
+                scratch->rotate(SPAWN_X, 0);
+            }
+            delete scratch;
+        }
+        x = savedX;
+    }
+
+    static int pieceType(const Piece* piece) {
+        for (int i = 0; i < 16; i++) {
+            int type = getPieceIndex(piece->shape[i / 4][i % 4]);
+            if (type >= 0) return type;
+        }
+        return 0;
+    }
+
+/** Index of the piece's current shape among its type's rotations */
+    static int rotationIndex(const Piece* piece, int type) {
+        const PieceShapes& rotations = shapes[type];
+        for (int r = 0; r < rotations.count; r++) {
+            if (std::memcmp(piece->shape, rotations.rotations[r].shape, sizeof(piece->shape)) == 0) return r;
+        }
+        return 0;
+    }
+
+    static Evaluator makeEvaluator(const Weights& weights) {
+        Evaluator eval;
+        std::uint64_t salt = 0x51A7ull;
+        for (int i = 0; i < Features::FEATURE_COUNT; i++) {
+            eval.weights[i] = static_cast<std::int32_t>(std::lround(weights.values[i] * WEIGHT_SCALE));
+            salt = (salt ^ static_cast<std::uint32_t>(eval.weights[i])) * 0x100000001B3ull;
+            salt ^= salt >> 29;
+        }
+        eval.salt = salt;
+        return eval;
+    }
+
+    static std::int32_t evaluate(const Evaluator& eval, const Rows& rows) {
+        Features::Vector features = Features::extract(rows);
+        std::int32_t score = 0;
+        for (int i = 0; i < Features::FEATURE_COUNT; i++) score += eval.weights[i] * features.values[i];
+        return score;
+    }
+
+/** Whether rot fits with its 4x4 box at board column (walls included) and row */
+    static bool fits(const Rows& rows, const Rotation& rot, int column, int row) {
+        return rows.fits(rot.rowBits, column - 1, row);
+    }
+
+    // A placement result: the board after the drop and line clears and its
+    // Zobrist board key.
+    struct Landing {
+        Rows rows;
+        std::uint64_t hash;
+    };
+
+/** Hard-drop rot at column from the top, as getGhostY would, then clear full rows */
+    static void land(const Rows& rows, const int (&tops)[COLS], std::uint64_t hash,
+                     const Rotation& rot, int column, Landing& out) {
+        int drop = ROWS;
+        for (int j = 0; j < 4; j++) {
+            if (rot.bottom[j] < 0) continue;
+            int col = column + j - 1;
+            drop = std::min(drop, tops[col] - rot.bottom[j] - 1);
+        }
+        // An overhang above the spawn row hides the real landing spot from
+        // the column tops, so walk the piece down instead.
+        if (drop < 0) {
+            drop = 0;
+            while (fits(rows, rot, column, drop + 1)) drop++;
+        }
+        out.rows = rows;
+        bool full = false;
+        for (int i = 0; i < 4; i++) {
+            if (!rot.rowBits[i]) continue;
+            Rows::Row mask;
+            if (!Rows::placeRow(rot.rowBits[i], column - 1, mask)) continue;
+            int r = drop + i;
+            out.rows.bits[r] |= mask;
+            hash ^= Zobrist::rowKey(r, static_cast<std::uint16_t>(mask << 1));
+            full |= r > 0 && out.rows.bits[r] == FULL_ROW;
+        }
+        if (!full) {
+            out.hash = hash;
+            return;
+        }
+
+        // Cleared rows shift everything above them, so rehash from scratch.
+        out.rows.clearFullRows();
+        out.hash = 0;
+        for (int r = 0; r < ROWS; r++) out.hash ^= Zobrist::rowKey(r, static_cast<std::uint16_t>(out.rows.bits[r] << 1));
+    }
+
+/** Visit every rotation/column reachable by sliding along the spawn row */
+    template <typename Visit>
+    static void forEachPlacement(const Rows& rows, int type, Visit visit) {
+        const PieceShapes& piece = shapes[type];
+        for (int r = 0; r < piece.count; r++) {
+            const Rotation& rot = piece.rotations[r];
+            if (!fits(rows, rot, SPAWN_X, 0)) continue;
+            int left = SPAWN_X, right = SPAWN_X;
+            while (fits(rows, rot, left - 1, 0)) left--;
+            while (fits(rows, rot, right + 1, 0)) right++;
+            for (int column = left; column <= right; column++) visit(r, column);
+        }
+    }
+
+/** Best score over placements of type on rows; cached in the shared table */
+    static std::int32_t bestReply(const Evaluator& eval, const Landing& board, int type) {
+        std::uint64_t key = board.hash ^ Zobrist::keys.active[type] ^ eval.salt;
+        TransTable::Entry entry;
+        if (TransTable::probe(key, entry)) return entry.score;
+
+        int tops[COLS];
+        board.rows.columnTops(tops);
+        std::int32_t best = LOSS;
+        int bestMove = 0, move = 0;
+        Landing next;
+        forEachPlacement(board.rows, type, [&](int r, int column) {
+            land(board.rows, tops, board.hash, shapes[type].rotations[r], column, next);
+            std::int32_t score = evaluate(eval, next.rows);
+            if (score > best) {
+                best = score;
+                bestMove = move;
+            }
+            move++;
+        });
+        TransTable::store(key, best, static_cast<std::uint16_t>(bestMove), 1);
+        return best;
+    }
+
+/** Best placement of type on the live board; followType < 0 skips lookahead */
+    static std::int32_t choose(const Evaluator& eval, const Rows& rows, const int (&tops)[COLS],
+                               int type, int followType, Placement& out) {
+        std::int32_t best = LOSS;
+        out = {0, SPAWN_X};
+        Landing landing;
+        forEachPlacement(rows, type, [&](int r, int column) {
+            land(rows, tops, boardHash, shapes[type].rotations[r], column, landing);
+            std::int32_t score = followType >= 0 ? bestReply(eval, landing, followType)
+                                                 : evaluate(eval, landing.rows);
+            if (score > best) {
+                best = score;
+                out = {r, column};
+            }
+        });
+        return best;
+    }
+
+/** Run the simulation for about seconds in frontend-sized ticks */
+    static void wait(float seconds) {
+        const float tick = SIM_TICK_MS / 1000.f;
+        for (float t = tick / 2; t < seconds; t += tick) advanceGame(tick);
+    }
+
+    static void press(GameKey key, float keyTime) {
+        onGameKey(key, true);
+        wait(keyTime);
+        onGameKey(key, false);
+        wait(keyTime);
+    }
+
+    void playPiece(const Weights& weights, bool lookahead, float keyTime) {
+        if (isGameOver || !currentPiece) return;
+        Evaluator eval = makeEvaluator(weights);
+        Rows rows = Features::fromBoard(board);
+        int tops[COLS];
+        rows.columnTops(tops);
+
+        int current = pieceType(currentPiece);
+        int next = nextPiece ? pieceType(nextPiece) : -1;
+        Placement stay;
+        std::int32_t stayScore = choose(eval, rows, tops, current, lookahead ? next : -1, stay);
+
+        // Holding swaps in the held piece, or the next one when hold is
+        // empty, in which case the piece after that becomes the lookahead.
+        bool useHold = false;
+        Placement swap = stay;
+        if (canHold && nextPiece) {
+            int held = holdPiece ? pieceType(holdPiece) : next;
+            int follow = holdPiece ? next : pieceType(nextQueue[0]);
+            std::int32_t holdScore = choose(eval, rows, tops, held, lookahead ? follow : -1, swap);
+            useHold = holdScore > stayScore;
+        }
+
+        if (useHold) {
+            press(GameKey::HOLD, keyTime);
+            current = pieceType(currentPiece);
+            stay = swap;
+        }
+
+        const PieceShapes& piece = shapes[current];
+        int turns = (stay.rotation - rotationIndex(currentPiece, current) + piece.count) % piece.count;
+        for (int i = 0; i < turns; i++) press(GameKey::ROTATE, keyTime);
+        for (int i = 0; i < W && x != stay.column; i++) {
+            int before = x;
+            press(x > stay.column ? GameKey::LEFT : GameKey::RIGHT, keyTime);
+            if (x == before) break;
+        }
+        int locked = totalPieces;
+        press(GameKey::HARD_DROP, keyTime);
+        if (keyTime <= 0.f) {
+            advanceGame(LOCK_DELAY);
+            return;
+        }
+        while (!isGameOver && totalPieces == locked) wait(keyTime);
+    }
+
+    GameResult playGame(const Weights& weights, unsigned seed, int maxPieces, bool lookahead) {
+        resetGame(seed);
+        while (!isGameOver && totalPieces < maxPieces) playPiece(weights, lookahead);
+        return {gScore, gLines, totalPieces, isGameOver};
+    }
+}
@@ -0,0 +1,41 @@
+/*
+ * Tetris Game - Heuristic placement bot
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Features.h"
+#include <cstdint>
+
+// The bot plays the calling thread's live game through onGameKey, like a
+// player would. For the current piece and the hold alternative it tries
+// every rotation and column that can be reached from spawn, drops it on a
+// bitboard copy, and scores the result as a weighted sum of Features. With
+// lookahead each placement is scored by the best placement of the piece
+// after it. Those second-ply results are cached in the shared TransTable,
+// keyed by board hash, piece and a per-weight-set salt. Evaluation is
+// integer-only, so a game plays the same with or without cache hits.
+// With a keyTime the keys are paced like a player's: every press and
+// release is followed by that much game time in SIM_TICK_MS steps, and
+// the hard-dropped piece locks through the normal lock delay.
+namespace Bot {
+    const float WEIGHT_SCALE = 1024.f;
+
+    struct Weights {
+        float values[Features::FEATURE_COUNT];
+    };
+
+    struct GameResult {
+        int score;
+        int lines;
+        int pieces;
+        bool toppedOut;
+    };
+
+    Weights defaultWeights();
+
+    void init();
+    void playPiece(const Weights& weights, bool lookahead, float keyTime = 0.f);
+    GameResult playGame(const Weights& weights, unsigned seed, int maxPieces, bool lookahead);
+}
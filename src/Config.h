@@ -16,6 +16,11 @@ const int PLAY_H_PX = H * TILE_SIZE;
 const int WINDOW_W = 800;
 const int WINDOW_H = 800;
 
+const int TARGET_FPS = 60;
+const int BACKGROUND_FPS = 10;
+const int IDLE_WAIT_MS = 250;
+const int SIM_TICK_MS = 4;
+
 enum class GameState {
     MENU,
     PLAYING,
@@ -29,3 +34,23 @@ enum class Difficulty {
     NORMAL,
     HARD
 };
+
+enum class GameMode {
+    MARATHON,
+    VERSUS,
+    PRACTICE,
+    COUNT
+};
+
+const int DIFFICULTY_COUNT = 3;
+
+enum class GameKey {
+    LEFT,
+    RIGHT,
+    DOWN,
+    ROTATE,
+    HARD_DROP,
+    HOLD,
+    UNDO,
+    COUNT
+};
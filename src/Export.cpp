@@ -0,0 +1,249 @@
+/*
+ * Tetris Game - Offscreen replay export implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Export.h"
+#include "Game.h"
+#include "Jobs.h"
+#include "Render.h"
+#include "Replay.h"
+#include "TileShader.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace Export {
+
+    // One frame between readback and output. The drawing thread reuses a
+    // slot only after writing out the frame that was in it, so at most
+    // PIPELINE_DEPTH frames are being encoded at once.
+    struct Slot {
+        Jobs::Group encoded;
+        sf::Image image;
+        std::string bytes;
+        bool busy = false;
+    };
+
+    static const int PIPELINE_DEPTH = 16;
+    static const char Y4M_FRAME[] = "FRAME\n";
+
+    using Clock = std::chrono::steady_clock;
+
+    static double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+/** The game's fixed layout scaled to fit width x height, centred */
+    static sf::View letterboxView(unsigned width, unsigned height) {
+        sf::View view(sf::FloatRect({0.f, 0.f}, {(float)WINDOW_W, (float)WINDOW_H}));
+        float scale = std::min(width / (float)WINDOW_W, height / (float)WINDOW_H);
+        float viewW = WINDOW_W * scale / width;
+        float viewH = WINDOW_H * scale / height;
+        view.setViewport(sf::FloatRect({(1.f - viewW) / 2.f, (1.f - viewH) / 2.f}, {viewW, viewH}));
+        return view;
+    }
+
+/** A chroma sample from its weighted sum over a 2x2 block (weights sum to 256 per pixel) */
+    static std::uint8_t chroma(int weighted) {
+        int value = 128 + (weighted >= 0 ? (weighted + 512) >> 10 : -((-weighted + 512) >> 10));
+        return static_cast<std::uint8_t>(std::min(255, std::max(0, value)));
+    }
+
+/** One Y4M frame from RGBA pixels: full-range BT.601 luma, chroma averaged over 2x2 blocks */
+    static void encodeY4M(const sf::Image& image, std::string& out) {
+        const unsigned w = image.getSize().x, h = image.getSize().y;
+        const std::uint8_t* rgba = image.getPixelsPtr();
+        const std::size_t header = sizeof(Y4M_FRAME) - 1;
+        out.resize(header + w * h + 2 * (w / 2) * (h / 2));
+        std::memcpy(&out[0], Y4M_FRAME, header);
+        std::uint8_t* luma = reinterpret_cast<std::uint8_t*>(&out[header]);
+        std::uint8_t* cb = luma + w * h;
+        std::uint8_t* cr = cb + (w / 2) * (h / 2);
+
+        for (unsigned i = 0; i < w * h; i++) {
+            const std::uint8_t* p = rgba + i * 4;
+            luma[i] = static_cast<std::uint8_t>((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+        for (unsigned row = 0; row < h / 2; row++) {
+            for (unsigned col = 0; col < w / 2; col++) {
+                const std::uint8_t* top = rgba + ((row * 2) * w + col * 2) * 4;
+                const std::uint8_t* bottom = top + w * 4;
+                int r = top[0] + top[4] + bottom[0] + bottom[4];
+                int g = top[1] + top[5] + bottom[1] + bottom[5];
+                int b = top[2] + top[6] + bottom[2] + bottom[6];
+                cb[row * (w / 2) + col] = chroma(-43 * r - 85 * g + 128 * b);
+                cr[row * (w / 2) + col] = chroma(128 * r - 107 * g - 21 * b);
+            }
+        }
+    }
+
+/** Render the replay and write it out; returns the process exit code */
+    int run(const Options& options, const sf::Font& font) {
+        const bool y4m = options.format == Format::Y4M;
+        if (options.width < 16 || options.height < 16 || options.width > 8192 || options.height > 8192 ||
+            options.fps < 1 || options.fps > 240) {
+            std::fprintf(stderr, "Export: size must be 16-8192 pixels per side and fps 1-240\n");
+            return 1;
+        }
+        if (y4m && (options.width % 2 != 0 || options.height % 2 != 0)) {
+            std::fprintf(stderr, "Export: Y4M needs an even width and height\n");
+            return 1;
+        }
+
+        Replay::Recording recording;
+        if (!Replay::load(options.replay, recording)) {
+            std::fprintf(stderr, "Export: cannot read replay %s\n", options.replay.c_str());
+            return 1;
+        }
+
+        std::string out = options.out;
+        if (out.empty()) {
+            std::filesystem::path path(options.replay);
+            out = y4m ? path.replace_extension(".y4m").string()
+                      : path.replace_extension("").string() + "_frames";
+        }
+
+        sf::RenderTexture target;
+        if (!target.resize({options.width, options.height}) || !target.setActive(true)) {
+            std::fprintf(stderr, "Export: cannot create a %ux%u offscreen target\n", options.width, options.height);
+            return 1;
+        }
+        bool shaderTiles = TileShader::load();
+
+        std::FILE* stream = nullptr;
+        if (y4m && out == "-") {
+#ifdef _WIN32
+            _setmode(_fileno(stdout), _O_BINARY);
+#endif
+            stream = stdout;
+        } else if (y4m) {
+            stream = std::fopen(out.c_str(), "wb");
+        } else {
+            std::error_code ec;
+            std::filesystem::create_directories(out, ec);
+        }
+        if (y4m && !stream) {
+            std::fprintf(stderr, "Export: cannot write %s\n", out.c_str());
+            TileShader::unload();
+            return 1;
+        }
+        if (y4m) {
+            std::fprintf(stream, "YUV4MPEG2 W%u H%u F%d:1 Ip A1:1 C420jpeg\n",
+                         options.width, options.height, options.fps);
+        }
+
+        // The exported game shows its particles and line clears but is not
+        // a game the player played: no sounds, scores or telemetry.
+        effectsEnabled = true;
+        resultsEnabled = false;
+        Replay::Cursor cursor;
+        Replay::start(recording, cursor);
+
+        Render::Frame& frame = Render::frame();
+        frame.state = GameState::PLAYING;
+        frame.live = true;
+        frame.focused = true;
+        frame.debugOverlay = false;
+        frame.versus = frame.versusWaiting = frame.desynced = false;
+        frame.watching = false;
+        frame.replay = true;
+        frame.versusResult = 0;
+        frame.rankedGames = 0;
+        frame.practiceDepth = 0;
+        frame.view = letterboxView(options.width, options.height);
+
+        std::vector<Slot> slots(PIPELINE_DEPTH);
+        std::atomic<bool> failed{false};
+        bool writeFailed = false;
+        auto finish = [&](Slot& slot) {
+            Jobs::wait(slot.encoded);
+            slot.busy = false;
+            if (y4m && !writeFailed && std::fwrite(slot.bytes.data(), 1, slot.bytes.size(), stream) != slot.bytes.size()) {
+                writeFailed = true;
+            }
+        };
+
+        const float dt = 1.f / options.fps;
+        const int holdFrames = HOLD_SECONDS * options.fps;
+        double drawSeconds = 0.0, readbackSeconds = 0.0, waitSeconds = 0.0;
+        Clock::time_point begin = Clock::now();
+        bool playing = true;
+        int held = 0;
+        int frames = 0;
+        for (; playing || held < holdFrames; frames++) {
+            if (playing) {
+                playing = Replay::play(recording, cursor, static_cast<double>(frames) / options.fps);
+            } else {
+                held++;
+            }
+
+            Slot& slot = slots[frames % PIPELINE_DEPTH];
+            if (slot.busy) {
+                Clock::time_point waitStart = Clock::now();
+                finish(slot);
+                waitSeconds += secondsSince(waitStart);
+            }
+            if (writeFailed) break;
+
+            Clock::time_point drawStart = Clock::now();
+            Render::drawOffscreen(target, font, dt);
+            target.display();
+            Clock::time_point readStart = Clock::now();
+            slot.image = target.getTexture().copyToImage();
+            drawSeconds += std::chrono::duration<double>(readStart - drawStart).count();
+            readbackSeconds += secondsSince(readStart);
+
+            slot.busy = true;
+            if (y4m) {
+                Jobs::run(slot.encoded, [&slot] { encodeY4M(slot.image, slot.bytes); });
+            } else {
+                char name[32];
+                std::snprintf(name, sizeof(name), "frame_%06d.png", frames);
+                std::string path = (std::filesystem::path(out) / name).string();
+                Jobs::run(slot.encoded, [&slot, &failed, path] {
+                    if (!slot.image.saveToFile(path)) failed.store(true);
+                });
+            }
+        }
+        for (int i = 0; i < PIPELINE_DEPTH; i++) {
+            Slot& slot = slots[(frames + i) % PIPELINE_DEPTH];
+            if (slot.busy) finish(slot);
+        }
+        double seconds = secondsSince(begin);
+
+        TileShader::unload();
+        (void)target.setActive(false);
+        if (stream && stream != stdout) {
+            if (std::fclose(stream) != 0) writeFailed = true;
+        } else if (stream) {
+            std::fflush(stream);
+        }
+        if (writeFailed || failed.load()) {
+            std::fprintf(stderr, "Export: writing %s failed\n", out.c_str());
+            return 1;
+        }
+
+        double gameSeconds = cursor.time;
+        std::fprintf(stderr, "Export: %s -> %s\n", options.replay.c_str(), out.c_str());
+        std::fprintf(stderr, "  %d frames at %ux%u, %d fps, %.1f s of game in %.2f s: %.1f frames/s, %.1fx real time\n",
+                     frames, options.width, options.height, options.fps, gameSeconds, seconds,
+                     frames / seconds, frames / static_cast<double>(options.fps) / seconds);
+        std::fprintf(stderr, "  per frame: draw %.2f ms, readback %.2f ms, waiting on %u encoder threads %.2f ms (%s tiles)\n",
+                     drawSeconds * 1000.0 / frames, readbackSeconds * 1000.0 / frames,
+                     Jobs::workerCount(), waitSeconds * 1000.0 / frames,
+                     shaderTiles ? "shader" : "classic");
+        return 0;
+    }
+}
@@ -0,0 +1,42 @@
+/*
+ * Tetris Game - Offscreen replay export
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Config.h"
+#include <string>
+
+// --export <replay.rpl> renders a recorded game into a video without a
+// window, as fast as it can be drawn. The replay plays on the calling
+// thread at its recorded pace, sampled every 1/fps seconds of game time.
+// Each frame is drawn into a RenderTexture at the chosen size, with the
+// game letterboxed, and read back on that thread, which owns the GL
+// context. Job workers turn the pixels into a Y4M frame (4:2:0, full
+// range) or compress and write a PNG. Y4M frames are written in order to
+// a file or to stdout for piping into an encoder. After the last record
+// the final position is held for HOLD_SECONDS. Run times are reported on
+// stderr, so an export doubles as a rendering benchmark.
+namespace Export {
+    const int HOLD_SECONDS = 3;
+
+    enum class Format {
+        Y4M,
+        PNG,
+    };
+
+    // out is a .y4m path or "-" for stdout, or the PNG directory; empty
+    // means next to the replay.
+    struct Options {
+        std::string replay;
+        std::string out;
+        Format format = Format::Y4M;
+        unsigned width = WINDOW_W;
+        unsigned height = WINDOW_H;
+        int fps = 60;
+    };
+
+    int run(const Options& options, const sf::Font& font);
+}
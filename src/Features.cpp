@@ -0,0 +1,342 @@
+/*
+ * Tetris Game - Board evaluation features implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Features.h"
+#include <cstring>
+
+namespace Features {
+
+/** Pack the interior of a char board into row masks */
+    Rows fromBoard(const char (&board)[H][W]) {
+        Rows rows;
+        for (int i = 0; i < ROWS; i++) {
+            Rows::Row bits = 0;
+            for (int j = 0; j < COLS; j++) {
+                if (board[i][j + 1] != ' ') bits |= 1u << j;
+            }
+            rows.bits[i] = bits;
+        }
+        return rows;
+    }
+
+/** Per-byte popcount of a word; sums of these fit a byte for up to 31 words */
+    static inline std::uint64_t byteCounts(std::uint64_t x) {
+        x = x - ((x >> 1) & 0x5555555555555555ull);
+        x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+        return (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    }
+
+/** Sum of the eight byte counts in x */
+    static inline int byteTotal(std::uint64_t x) {
+        x = (x & 0x00FF00FF00FF00FFull) + ((x >> 8) & 0x00FF00FF00FF00FFull);
+        return static_cast<int>((x * 0x0001000100010001ull) >> 48);
+    }
+
+/** A lane value repeated in every lane of a 64-bit word */
+    template <int LaneBits, int Lanes>
+    constexpr std::uint64_t repeatLane(std::uint64_t lane) {
+        std::uint64_t out = 0;
+        for (int i = 0; i < Lanes; i++) out |= lane << (i * LaneBits);
+        return out;
+    }
+
+    // The feature kernels for one board geometry. A group is a run of
+    // consecutive rows side by side in one 64-bit word, one lane per row
+    // (lane 0 the top one), so every mask operation works on the whole
+    // group at once and one popcount counts a feature over all its rows.
+    // A lane holds a row and its two walls. Rows of 16 bits or less use
+    // Board::Row-sized lanes, which sit in memory order, so on a
+    // little-endian target a group is a single load; wider rows are packed
+    // as tightly as whole lanes allow (three 21-bit lanes for the 16-wide
+    // board rather than two of 32). No row mask reaches the top bit of its
+    // lane, which the lane tests use as their flag bit. Every size is a
+    // constant of Board, so each instantiation is straight-line code for
+    // its shape. Popcnt picks the counting: the popcnt instruction, or SWAR
+    // byte counts summed over groups and added up once at the end.
+    template <typename Board, bool Popcnt>
+    struct Kernels {
+        using Word = typename Board::Word;
+        using Lanes = std::uint64_t;
+        static constexpr int ROWS = Board::ROWS;
+        static constexpr int COLS = Board::COLS;
+        static constexpr Word FULL_ROW = Board::FULL_ROW;
+        static constexpr bool ROW_LANES = sizeof(typename Board::Row) <= 2;
+        static constexpr int PER_GROUP = ROW_LANES ? 64 / (8 * sizeof(typename Board::Row)) : 64 / (COLS + 2);
+        static constexpr int LANE_BITS = 64 / PER_GROUP;
+        static constexpr int LAST_LANE = (PER_GROUP - 1) * LANE_BITS;
+        static constexpr Lanes ALL = PER_GROUP * LANE_BITS == 64 ? ~Lanes(0) : (Lanes(1) << (PER_GROUP * LANE_BITS)) - 1;
+        // Groups are aligned to the floor, so the top one sticks out above
+        // the board when the rows do not divide evenly.
+        static constexpr int FIRST_GROUP = ROWS % PER_GROUP ? ROWS % PER_GROUP - PER_GROUP : 0;
+        static_assert(Popcnt || (ROWS + PER_GROUP - 1) / PER_GROUP <= 31, "byte counts of more than 31 groups overflow");
+        static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "groups are loaded as little-endian words");
+
+        static constexpr Lanes ONE = repeatLane<LANE_BITS, PER_GROUP>(1);
+        static constexpr Lanes FLAG = repeatLane<LANE_BITS, PER_GROUP>(Lanes(1) << (LANE_BITS - 1));
+        static constexpr Lanes FULL = repeatLane<LANE_BITS, PER_GROUP>(FULL_ROW);
+        static constexpr Lanes EDGES = repeatLane<LANE_BITS, PER_GROUP>(Board::EDGE_COLUMNS);
+        static constexpr Lanes INNER_PAIRS = repeatLane<LANE_BITS, PER_GROUP>(FULL_ROW >> 1);
+        static constexpr Lanes WALL_ROWS = repeatLane<LANE_BITS, PER_GROUP>((Lanes(1) << (COLS + 1)) - 1);
+        static constexpr Lanes WALL_BITS = repeatLane<LANE_BITS, PER_GROUP>(Lanes(1) | Lanes(1) << (COLS + 1));
+        static constexpr Lanes RIGHT_WALL = repeatLane<LANE_BITS, PER_GROUP>(Lanes(1) << (COLS - 1));
+
+/** Set bits in a row-sized mask; SWAR when the target has no popcnt instruction */
+        static inline int popcount(Word bits) {
+#ifdef __POPCNT__
+            return sizeof(Word) <= 4 ? __builtin_popcount(static_cast<std::uint32_t>(bits))
+                                     : __builtin_popcountll(static_cast<unsigned long long>(bits));
+#else
+            return byteTotal(byteCounts(bits));
+#endif
+        }
+
+/** Rows r, r+1, ... as lanes; rows above the board read as empty */
+        static inline Lanes load(const Board& rows, int r) {
+            Lanes group = 0;
+            if (ROW_LANES && r >= 0) {
+                std::memcpy(&group, &rows.bits[r], sizeof(group));
+            } else if (r >= 0) {
+                for (int i = 0; i < PER_GROUP; i++) group |= Lanes(rows.bits[r + i]) << (i * LANE_BITS);
+            } else {
+                for (int i = -r; i < PER_GROUP; i++) group |= Lanes(rows.bits[r + i]) << (i * LANE_BITS);
+            }
+            return group;
+        }
+
+/** Each lane moved one row down; lane 0 takes the row above the group */
+        static inline Lanes shiftDown(Lanes group, Lanes above) {
+            if constexpr (PER_GROUP == 1) return above;
+            else return ((group << LANE_BITS) & ALL) | above;
+        }
+
+/** Each lane ORed with every lane above it */
+        static inline Lanes prefixOr(Lanes group) {
+            for (int shift = LANE_BITS; shift < PER_GROUP * LANE_BITS; shift *= 2) group |= group << shift;
+            return group & ALL;
+        }
+
+/** FLAG set in every lane that is not zero */
+        static inline Lanes nonZero(Lanes group) {
+            return (group + (FLAG - ONE)) & FLAG;
+        }
+
+        // One feature's count over every group so far.
+        struct Tally {
+            Lanes sum;
+
+            void add(Lanes group) {
+                if constexpr (Popcnt) sum += __builtin_popcountll(group);
+                else sum += byteCounts(group);
+            }
+
+            int total() const {
+                if constexpr (Popcnt) return static_cast<int>(sum);
+                else return byteTotal(sum);
+            }
+        };
+
+        struct Totals {
+            int holes, holeRows, covered;
+        };
+
+        static int firstGroup(const Board& rows, int& top);
+        static void countHoles(const Board& rows, int top, Totals& totals);
+        static int deepWells(const Board& rows, int top);
+    };
+
+/** Start of the first group with a filled row, ROWS when empty; the filled row's index goes in top */
+    template <typename Board, bool Popcnt>
+    int Kernels<Board, Popcnt>::firstGroup(const Board& rows, int& top) {
+        int r = FIRST_GROUP;
+        Lanes group = 0;
+        while (r < ROWS && (group = load(rows, r)) == 0) r += PER_GROUP;
+        top = r < ROWS ? r + __builtin_ctzll(group) / LANE_BITS : ROWS;
+        return r;
+    }
+
+/** Holes, hole rows and the filled cells above each hole; rare on a playable stack */
+    template <typename Board, bool Popcnt>
+    void Kernels<Board, Popcnt>::countHoles(const Board& rows, int top, Totals& totals) {
+        Word seen = 0;
+        for (int r = top; r < ROWS; r++) {
+            Word holeMask = FULL_ROW & ~static_cast<Word>(rows.bits[r]) & seen;
+            if (holeMask) {
+                totals.holes += popcount(holeMask);
+                totals.holeRows++;
+                for (int k = top; k < r; k++) totals.covered += popcount(rows.bits[k] & holeMask);
+            }
+            seen |= rows.bits[r];
+        }
+    }
+
+/** What wells deeper than four add beyond the four unary masks: depth - 4 per cell */
+    template <typename Board, bool Popcnt>
+    int Kernels<Board, Popcnt>::deepWells(const Board& rows, int top) {
+        Word seen = 0, wells1 = 0, wells2 = 0, wells3 = 0, wells4 = 0, deep = 0;
+        std::uint8_t run[COLS] = {};
+        int sum = 0;
+        for (int r = top; r < ROWS && seen != FULL_ROW; r++) {
+            Word row = rows.bits[r];
+            Word flanked = ((row << 1) | 1) & ((row >> 1) | Word(1) << (COLS - 1));
+            Word wells = FULL_ROW & ~row & ~seen & flanked;
+            Word deeper = wells & wells4;
+            for (Word bits = deeper; bits; bits &= bits - 1) {
+                int col = Board::lowestBit(bits);
+                run[col] = (deep >> col & 1) ? run[col] + 1 : 1;
+                sum += run[col];
+            }
+            wells4 = wells & wells3;
+            wells3 = wells & wells2;
+            wells2 = wells & wells1;
+            wells1 = wells;
+            deep = deeper;
+            seen |= row;
+        }
+        return sum;
+    }
+
+    template <typename Board, bool Popcnt>
+    static inline __attribute__((always_inline)) Vector scan(const Board& rows) {
+        using K = Kernels<Board, Popcnt>;
+        using Lanes = typename K::Lanes;
+
+        int top;
+        int start = K::firstGroup(rows, top);
+
+        // Wells keep a cell's depth (capped at four) in binary.
+        typename K::Tally heights = {}, bumps = {}, rowChanges = {}, colChanges = {};
+        typename K::Tally depthOnes = {}, depthTwos = {}, depthFours = {};
+        typename K::Tally tSlots = {};
+        int fullRows = 0;
+
+        // The last row of the group before, and the lanes it left behind
+        // that the next group's lane 0 needs.
+        Lanes above = 0, twoAbove = 0, seen = 0;
+        Lanes wells1 = 0, wells2 = 0, wells3 = 0, wells4 = 0;
+        Lanes holes = 0, deep = 0;
+
+        for (int r = start; r < Board::ROWS; r += K::PER_GROUP) {
+            Lanes row = K::load(rows, r);
+            Lanes rowAbove = K::shiftDown(row, above);
+            Lanes rowTwoAbove = K::shiftDown(rowAbove, twoAbove);
+            twoAbove = rowAbove >> K::LAST_LANE;
+            above = row >> K::LAST_LANE;
+
+            // Full rows under full rows, with every column reached, add
+            // nothing but their height.
+            if (seen == Board::FULL_ROW && (row & rowAbove) == K::FULL) {
+                fullRows += K::PER_GROUP;
+                continue;
+            }
+
+            Lanes empty = K::FULL & ~row;
+            Lanes seenAfter = K::prefixOr(row | seen);
+            Lanes seenBefore = K::shiftDown(seenAfter, seen);
+            seen = seenAfter >> K::LAST_LANE;
+            holes |= empty & seenBefore;
+
+            heights.add(seenAfter);
+            bumps.add((seenAfter ^ (seenAfter >> 1)) & K::INNER_PAIRS);
+            Lanes walled = (row << 1) | K::WALL_BITS;
+            rowChanges.add((walled ^ (walled >> 1)) & K::WALL_ROWS);
+            colChanges.add(row ^ rowAbove);
+
+            // A well cell is open above and flanked by blocks or walls. It
+            // adds its depth in the well: one per unary mask (at least 1, 2,
+            // 3, 4 deep) it appears in, and deepWells() adds the rest. The
+            // masks are nested, so their parity and two more masks give the
+            // capped depth in binary.
+            Lanes flanked = ((row << 1) | K::ONE) & ((row >> 1) | K::RIGHT_WALL);
+            Lanes wells = empty & ~seenBefore & flanked;
+            Lanes depth2 = wells & K::shiftDown(wells, wells1);
+            Lanes depth3 = wells & K::shiftDown(depth2, wells2);
+            Lanes depth4 = wells & K::shiftDown(depth3, wells3);
+            deep |= wells & K::shiftDown(depth4, wells4);
+            depthOnes.add(wells ^ depth2 ^ depth3 ^ depth4);
+            depthTwos.add(depth2 & ~depth4);
+            depthFours.add(depth4);
+            wells1 = wells >> K::LAST_LANE;
+            wells2 = depth2 >> K::LAST_LANE;
+            wells3 = depth3 >> K::LAST_LANE;
+            wells4 = depth4 >> K::LAST_LANE;
+
+            // A TSD slot: a one-cell gap away from the walls, a three-wide
+            // gap above it, and a corner overhang above that.
+            Lanes sides = ((empty << 1) | (empty >> 1)) & K::FULL;
+            Lanes open = ~K::nonZero((K::FULL & ~rowAbove) ^ (empty | sides)) & K::nonZero(rowTwoAbove & sides);
+            // Few rows have that gap above them, so the rest is skipped
+            // for a group with none.
+            if (open & K::FLAG) {
+                Lanes single = K::nonZero(empty & ~K::EDGES) & ~K::nonZero(empty & ((empty | K::FLAG) - K::ONE));
+                tSlots.add(single & open & ~K::nonZero(rowTwoAbove & empty));
+            }
+        }
+
+        typename K::Totals totals = {};
+        if (holes) K::countHoles(rows, top, totals);
+        int wellSums = depthOnes.total() + 2 * depthTwos.total() + 4 * depthFours.total();
+        if (deep) wellSums += K::deepWells(rows, top);
+
+        // Empty rows above the first group add only their two wall
+        // transitions; those in it, or above the board, counted their own.
+        // The bottom row's gaps meet the floor. On a board filled to the
+        // top, the first row's cells border no empty row above.
+        int colTransitions = colChanges.total();
+        if (top < Board::ROWS) colTransitions += K::popcount(Board::FULL_ROW & ~rows.bits[Board::ROWS - 1]);
+        if (top == 0) colTransitions -= K::popcount(rows.bits[0]);
+
+        Vector out;
+        out.values[AGGREGATE_HEIGHT] = heights.total() + Board::COLS * fullRows;
+        out.values[MAX_HEIGHT] = Board::ROWS - top;
+        out.values[BUMPINESS] = bumps.total();
+        out.values[HOLES] = totals.holes;
+        out.values[HOLE_ROWS] = totals.holeRows;
+        out.values[COVERED_CELLS] = totals.covered;
+        out.values[ROW_TRANSITIONS] = rowChanges.total() + 2 * start;
+        out.values[COL_TRANSITIONS] = colTransitions;
+        out.values[WELL_SUMS] = wellSums;
+        out.values[T_SLOTS] = tSlots.total();
+        return out;
+    }
+
+    // x86 builds without -mpopcnt choose at run time between a copy of
+    // the scan compiled for the popcnt instruction and the SWAR one. Every
+    // other target's __builtin_popcountll is an instruction already.
+#if defined(__x86_64__) || defined(__i386__)
+    static bool detectPopcnt() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt");
+    }
+
+    static const bool HAS_POPCNT = detectPopcnt();
+
+    template <typename Board>
+    __attribute__((target("popcnt"))) static Vector scanPopcnt(const Board& rows) {
+        return scan<Board, true>(rows);
+    }
+#endif
+
+    template <typename Board>
+    Vector extract(const Board& rows) {
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__POPCNT__)
+        return HAS_POPCNT ? scanPopcnt(rows) : scan<Board, false>(rows);
+#else
+        return scan<Board, true>(rows);
+#endif
+    }
+
+    template Vector extract(const StandardBoard&);
+    template Vector extract(const GuidelineBoard&);
+    template Vector extract(const WideBoard&);
+
+    const char* name(int feature) {
+        static const char* names[FEATURE_COUNT] = {
+            "aggregate height", "max height", "bumpiness", "holes", "hole rows",
+            "covered cells", "row transitions", "col transitions", "well sums", "t-slots",
+        };
+        return feature >= 0 && feature < FEATURE_COUNT ? names[feature] : "?";
+    }
+}
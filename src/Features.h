@@ -0,0 +1,59 @@
+/*
+ * Tetris Game - Board evaluation features
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Board.h"
+#include <cstdint>
+
+// Evaluation features of a Board (Board.h). extract() computes every
+// feature in one top-down pass of shifts, masks and popcounts, taking as
+// many rows at a time as fit a 64-bit word (four on the 10-wide boards)
+// and skipping the empty rows above the stack. It is a template over the
+// board geometry, instantiated in Features.cpp for StandardBoard and the
+// variant boards.
+//   AGGREGATE_HEIGHT  sum of column heights
+//   MAX_HEIGHT        tallest column
+//   BUMPINESS         sum of |height difference| of neighbouring columns
+//   HOLES             empty cells with a filled cell somewhere above
+//   HOLE_ROWS         rows containing at least one hole
+//   COVERED_CELLS     for every hole, the filled cells above it
+//   ROW_TRANSITIONS   filled/empty changes along rows (walls count filled)
+//   COL_TRANSITIONS   filled/empty changes down columns (floor counts filled)
+//   WELL_SUMS         open cells flanked on both sides, 1+2+..+depth per well
+//   T_SLOTS           T-spin double slots ready for a T piece
+namespace Features {
+    using Rows = StandardBoard;
+    const int ROWS = Rows::ROWS;
+    const int COLS = Rows::COLS;
+    const Rows::Row FULL_ROW = Rows::FULL_ROW;
+
+    enum Feature {
+        AGGREGATE_HEIGHT,
+        MAX_HEIGHT,
+        BUMPINESS,
+        HOLES,
+        HOLE_ROWS,
+        COVERED_CELLS,
+        ROW_TRANSITIONS,
+        COL_TRANSITIONS,
+        WELL_SUMS,
+        T_SLOTS,
+        FEATURE_COUNT
+    };
+
+    struct Vector {
+        std::int32_t values[FEATURE_COUNT];
+    };
+
+    Rows fromBoard(const char (&board)[H][W]);
+    template <typename Board>
+    Vector extract(const Board& rows);
+    const char* name(int feature);
+
+    extern template Vector extract(const StandardBoard&);
+    extern template Vector extract(const GuidelineBoard&);
+    extern template Vector extract(const WideBoard&);
+}
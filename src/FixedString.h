@@ -0,0 +1,53 @@
+/*
+ * Tetris Game - Fixed-capacity string
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+// A null-terminated string stored inline, for HUD text built every frame
+// on the stack. Text that does not fit is truncated rather than moved to
+// the heap, so size Capacity for the longest label plus its number.
+template <std::size_t Capacity>
+class FixedString {
+    static_assert(Capacity > 0, "Capacity must leave room for the terminator");
+
+public:
+    FixedString() { clear(); }
+
+    void clear() {
+        size_ = 0;
+        data_[0] = '\0';
+    }
+
+    /** Append plain text */
+    FixedString& append(const char* text) {
+        std::size_t length = std::strlen(text);
+        if (length > Capacity - 1 - size_) length = Capacity - 1 - size_;
+        std::memcpy(data_ + size_, text, length);
+        size_ += length;
+        data_[size_] = '\0';
+        return *this;
+    }
+
+    /** Append printf-formatted text */
+    template <typename... Args>
+    FixedString& format(const char* fmt, Args... args) {
+        int written = std::snprintf(data_ + size_, Capacity - size_, fmt, args...);
+        if (written <= 0) return *this;
+        std::size_t length = static_cast<std::size_t>(written);
+        size_ += length < Capacity - size_ ? length : Capacity - 1 - size_;
+        return *this;
+    }
+
+    const char* c_str() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    std::size_t size_;
+    char data_[Capacity];
+};
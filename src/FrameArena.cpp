@@ -0,0 +1,48 @@
+/*
+ * Tetris Game - Per-frame scratch arena implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "FrameArena.h"
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+namespace FrameArena {
+
+    static thread_local std::unique_ptr<unsigned char[]> block;
+    static thread_local std::size_t offset = 0;
+
+    void* allocate(std::size_t size, std::size_t align) {
+        if (!block) block.reset(new unsigned char[CAPACITY]);
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.get());
+        std::size_t start = ((base + offset + align - 1) & ~static_cast<std::uintptr_t>(align - 1)) - base;
+        if (start > CAPACITY || size > CAPACITY - start) return nullptr;
+        offset = start + size;
+        return block.get() + start;
+    }
+
+    void reset() {
+        offset = 0;
+    }
+
+    std::size_t used() {
+        return offset;
+    }
+
+    const char* format(const char* fmt, ...) {
+        char* text = static_cast<char*>(allocate(1, 1));
+        if (!text) return "";
+        std::size_t room = CAPACITY - offset + 1;
+        va_list args;
+        va_start(args, fmt);
+        int written = std::vsnprintf(text, room, fmt, args);
+        va_end(args);
+        std::size_t length = written > 0 ? static_cast<std::size_t>(written) : 0;
+        // Keep the string and its terminator; the 1 byte was already taken.
+        offset += length < room ? length : room - 1;
+        return text;
+    }
+}
@@ -0,0 +1,32 @@
+/*
+ * Tetris Game - Per-frame scratch arena
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+// Scratch memory that lives until the end of the current frame. Each
+// thread that draws gets one fixed block, taken from the heap on first
+// use; allocate() bumps a pointer through it and reset() moves the
+// pointer back once per frame, so nothing is freed piece by piece.
+// Requests that do not fit fail instead of falling back to the heap.
+namespace FrameArena {
+    const std::size_t CAPACITY = 64 * 1024;
+
+    void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+    void reset();
+    std::size_t used();
+
+    /** printf into the arena; truncated when the arena is nearly full */
+    const char* format(const char* fmt, ...);
+
+    /** Room for count Ts that need no destructor, or null when full */
+    template <typename T>
+    T* array(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+}
@@ -6,32 +6,45 @@
 
 #include "Game.h"
 #include "Audio.h"
-#include "UI.h"
+#include "Render.h"
+#include "Persist.h"
+#include "Leaderboard.h"
+#include "Telemetry.h"
+#include "Practice.h"
+#include "Replay.h"
+#include "Rules.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <sstream>
 
-char board[H][W] = {};
-int x = 4, y = 0;
-float gameDelay = 0.8f;
-float baseDelay = 0.8f;
-bool isGameOver = false;
+thread_local char board[H][W] = {};
+thread_local std::uint64_t boardHash = 0;
+thread_local int x = 4, y = 0;
+thread_local float gameDelay = 0.8f;
+thread_local float baseDelay = 0.8f;
+thread_local bool isGameOver = false;
 
-int gScore = 0;
-int gLines = 0;
-int gLevel = 0;
-int currentLevel = 0;
-int highScore = 0;
+thread_local int gScore = 0;
+thread_local int gLines = 0;
+thread_local int gLevel = 0;
+thread_local int currentLevel = 0;
+thread_local int highScore = 0;
 
-int comboCount = 0;
-int lastClearLines = 0;
+thread_local int comboCount = 0;
+thread_local int lastClearLines = 0;
 
-bool lastMoveWasRotate = false;
-bool backToBackActive = false;
-int tSpinCount = 0;
+thread_local bool lastMoveWasRotate = false;
+thread_local bool backToBackActive = false;
+thread_local int tSpinCount = 0;
 
-float playTime = 0.f;
-int tetrisCount = 0;
-int totalPieces = 0;
-int pieceCount[7] = {0, 0, 0, 0, 0, 0, 0};
+thread_local float playTime = 0.f;
+thread_local int tetrisCount = 0;
+thread_local int totalPieces = 0;
+thread_local int pieceCount[7] = {0, 0, 0, 0, 0, 0, 0};
 
 /** Get index of tetromino piece type */
 int getPieceIndex(char c) {
@@ -47,33 +60,49 @@ int getPieceIndex(char c) {
     }
 }
 
-Piece* currentPiece = nullptr;
-Piece* nextPiece = nullptr;
-Piece* nextQueue[4] = {nullptr, nullptr, nullptr, nullptr};
-Piece* holdPiece = nullptr;
-bool canHold = true;
-
-Difficulty difficulty = Difficulty::NORMAL;
-
-int pieceBag[7] = {0, 1, 2, 3, 4, 5, 6};
-int bagIndex = 7;
-
-float dasTimer = 0.f;
-float arrTimer = 0.f;
-bool leftHeld = false;
-bool rightHeld = false;
-bool downHeld = false;
-float DAS_DELAY = 0.133f;
-float ARR_DELAY = 0.0f;
-
-float lockTimer = 0.f;
-int lockMoves = 0;
-bool onGround = false;
-
-float musicVolume = 50.f;
-float sfxVolume = 50.f;
-float brightness = 255.f;
-bool ghostPieceEnabled = true;
+thread_local Piece* currentPiece = nullptr;
+thread_local Piece* nextPiece = nullptr;
+thread_local Piece* nextQueue[4] = {nullptr, nullptr, nullptr, nullptr};
+thread_local Piece* holdPiece = nullptr;
+thread_local bool canHold = true;
+
+thread_local Difficulty difficulty = Difficulty::NORMAL;
+thread_local GameMode gameMode = GameMode::MARATHON;
+
+thread_local int pieceBag[7] = {0, 1, 2, 3, 4, 5, 6};
+thread_local int bagIndex = 7;
+thread_local std::minstd_rand bagRng;
+thread_local unsigned gameSeed = 0;
+thread_local int gameOverRank = 0;
+
+thread_local float dasTimer = 0.f;
+thread_local float arrTimer = 0.f;
+thread_local float softDropTimer = 0.f;
+thread_local bool leftHeld = false;
+thread_local bool rightHeld = false;
+thread_local bool downHeld = false;
+thread_local float DAS_DELAY = 0.133f;
+thread_local float ARR_DELAY = 0.0f;
+
+thread_local float lockTimer = 0.f;
+thread_local int lockMoves = 0;
+thread_local bool onGround = false;
+
+thread_local float gravityTimer = 0.f;
+thread_local bool blockInput = false;
+
+thread_local int pendingGarbage = 0;
+thread_local int garbageSent = 0;
+thread_local std::minstd_rand garbageRng;
+bool effectsEnabled = true;
+bool resultsEnabled = true;
+
+thread_local float musicVolume = 50.f;
+thread_local float sfxVolume = 50.f;
+thread_local float brightness = 255.f;
+thread_local bool ghostPieceEnabled = true;
+thread_local bool instantSoftDrop = false;
+std::string playerName = "player";
 
 /** Get game speed delay for current difficulty */
 float getBaseDelayForDifficulty() {
@@ -96,16 +125,28 @@ void loadHighScore() {
 
 /** Process close */
 void saveHighScore() {
+    if (gameMode == GameMode::PRACTICE) return;
     if (gScore > highScore) {
         highScore = gScore;
-        std::ofstream file("highscore.dat");
-        if (file.is_open()) {
-            file << highScore;
-            file.close();
-        }
+        Persist::writeFile("highscore.dat", std::to_string(highScore));
     }
 }
 
+/** Append the finished game to the leaderboard and remember its rank */
+void recordFinishedGame() {
+    Leaderboard::Record record = {};
+    record.finishedAt = static_cast<std::int64_t>(std::time(nullptr));
+    record.score = gScore;
+    record.lines = gLines;
+    record.level = gLevel;
+    record.seed = gameSeed;
+    record.playTime = playTime;
+    record.ppm = playTime > 0.f ? totalPieces * 60.f / playTime : 0.f;
+    record.difficulty = static_cast<std::uint8_t>(difficulty);
+    record.mode = static_cast<std::uint8_t>(gameMode);
+    gameOverRank = Leaderboard::submit(record);
+}
+
 /** Process close */
 void loadSettings() {
     std::ifstream file("config.ini");
@@ -122,11 +163,15 @@ void loadSettings() {
                 ghostPieceEnabled = (line.substr(11) == "1");
             } else if (line.find("difficulty=") == 0) {
                 int diff = std::stoi(line.substr(11));
-                difficulty = static_cast<Difficulty>(diff);
+                difficulty = static_cast<Difficulty>(std::min(std::max(diff, 0), DIFFICULTY_COUNT - 1));
             } else if (line.find("dasDelay=") == 0) {
                 DAS_DELAY = std::stof(line.substr(9));
             } else if (line.find("arrDelay=") == 0) {
                 ARR_DELAY = std::stof(line.substr(9));
+            } else if (line.find("instantSoftDrop=") == 0) {
+                instantSoftDrop = (line.substr(16) == "1");
+            } else if (line.find("player=") == 0) {
+                playerName = line.substr(7);
             }
         }
         file.close();
@@ -135,30 +180,23 @@ void loadSettings() {
 
 /** Process close */
 void saveSettings() {
-    std::ofstream file("config.ini");
-    if (file.is_open()) {
-        file << "musicVolume=" << musicVolume << "\n";
-        file << "sfxVolume=" << sfxVolume << "\n";
-        file << "brightness=" << brightness << "\n";
-        file << "ghostPiece=" << (ghostPieceEnabled ? 1 : 0) << "\n";
-        file << "difficulty=" << static_cast<int>(difficulty) << "\n";
-        file << "dasDelay=" << DAS_DELAY << "\n";
-        file << "arrDelay=" << ARR_DELAY << "\n";
-        file.close();
-    }
+    std::ostringstream file;
+    file << "musicVolume=" << musicVolume << "\n";
+    file << "sfxVolume=" << sfxVolume << "\n";
+    file << "brightness=" << brightness << "\n";
+    file << "ghostPiece=" << (ghostPieceEnabled ? 1 : 0) << "\n";
+    file << "difficulty=" << static_cast<int>(difficulty) << "\n";
+    file << "dasDelay=" << DAS_DELAY << "\n";
+    file << "arrDelay=" << ARR_DELAY << "\n";
+    file << "instantSoftDrop=" << (instantSoftDrop ? 1 : 0) << "\n";
+    file << "player=" << playerName << "\n";
+    Persist::writeFile("config.ini", file.str());
 }
 
 /** Process close */
 void initBoard() {
-    for (int i = 0; i < H; i++) {
-        for (int j = 0; j < W; j++) {
-            if ((i == H - 1) || (j == 0) || (j == W - 1)) {
-                board[i][j] = '#';
-            } else {
-                board[i][j] = ' ';
-            }
-        }
-    }
+    Rules::init<StandardBoard>(board);
+    boardHash = 0;
 }
 
 /** Transfer current piece to the game board */
@@ -166,6 +204,7 @@ void block2Board() {
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 4; j++) {
             if (currentPiece->shape[i][j] != ' ') {
+                if (board[y + i][x + j] == ' ') boardHash ^= Zobrist::cellKey(y + i, x + j);
                 board[y + i][x + j] = currentPiece->shape[i][j];
             }
         }
@@ -175,41 +214,22 @@ void block2Board() {
 /** Check if piece can move in specified direction */
 bool canMove(int dx, int dy) {
     if (!currentPiece) return false;
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
-            if (currentPiece->shape[i][j] != ' ') {
-                int tx = x + j + dx;
-                int ty = y + i + dy;
-                if (tx < 1 || tx >= W - 1 || ty >= H - 1) return false;
-                if (board[ty][tx] != ' ') return false;
-            }
-        }
-    }
-    return true;
+    return Rules::fits<StandardBoard>(board, currentPiece->shape, x + dx, y + dy);
 }
 
-/** Calculate ghost piece Y position */
+/** Calculate ghost piece Y position from each column's lowest cell */
 int getGhostY() {
-    int ghostY = y;
-    while (true) {
-        bool canGo = true;
-        for (int i = 0; i < 4; i++) {
-            for (int j = 0; j < 4; j++) {
-                if (currentPiece->shape[i][j] != ' ') {
-                    int tx = x + j;
-                    int ty = ghostY + i + 1;
-                    if (ty >= H - 1 || board[ty][tx] != ' ') {
-                        canGo = false;
-                        break;
-                    }
-                }
-            }
-            if (!canGo) break;
-        }
-        if (!canGo) break;
-        ghostY++;
-    }
-    return ghostY;
+    return y + Rules::dropDistance<StandardBoard>(board, currentPiece->shape, x, y);
+}
+
+/** Count free cells between the piece and the nearest obstacle in dir (-1 or 1) */
+int getShiftDistance(int dir) {
+    return Rules::shiftDistance<StandardBoard>(board, currentPiece->shape, x, y, dir);
+}
+
+/** Height of the tallest column above the floor */
+int getStackHeight() {
+    return Rules::stackHeight<StandardBoard>(board);
 }
 
 /** Increase game speed based on level */
@@ -240,14 +260,13 @@ void applyLineClearScore(int cleared) {
     float comboMultiplier = 1.0f + (comboCount * 0.5f);
 
     int baseScore = 0;
-    std::string clearType = "";
 
     if (tSpin) {
 
         switch (cleared) {
-            case 1: baseScore = 800; clearType = "T-SPIN SINGLE"; break;
-            case 2: baseScore = 1200; clearType = "T-SPIN DOUBLE"; break;
-            case 3: baseScore = 1600; clearType = "T-SPIN TRIPLE"; break;
+            case 1: baseScore = 800; break;
+            case 2: baseScore = 1200; break;
+            case 3: baseScore = 1600; break;
             default: baseScore = 800;
         }
     } else {
@@ -256,7 +275,7 @@ void applyLineClearScore(int cleared) {
             case 1: baseScore = 100; break;
             case 2: baseScore = 300; break;
             case 3: baseScore = 500; break;
-            case 4: baseScore = 800; tetrisCount++; clearType = "TETRIS"; break;
+            case 4: baseScore = 800; tetrisCount++; break;
             default: baseScore = 100 * cleared;
         }
     }
@@ -264,7 +283,6 @@ void applyLineClearScore(int cleared) {
     float b2bMultiplier = 1.0f;
     if ((cleared == 4 || tSpin) && backToBackActive) {
         b2bMultiplier = 1.5f;
-        clearType += " B2B";
     }
 
     if (cleared == 4 || tSpin) {
@@ -275,7 +293,6 @@ void applyLineClearScore(int cleared) {
 
     if (perfectClear) {
         baseScore += 3000;
-        clearType += " PERFECT!";
     }
 
     gScore += static_cast<int>(baseScore * comboMultiplier * b2bMultiplier);
@@ -285,7 +302,7 @@ void applyLineClearScore(int cleared) {
     if (gLevel > currentLevel) {
         SpeedIncrement();
         currentLevel = gLevel;
-        Audio::playLevelUp();
+        if (effectsEnabled) Audio::playLevelUp();
     }
 }
 
@@ -296,42 +313,48 @@ int removeLine() {
     int clearedLines[4] = {-1, -1, -1, -1};
 
     for (int i = H - 2; i > 0; i--) {
-        bool isFull = true;
-        for (int j = 1; j < W - 1; j++) {
-            if (board[i][j] == ' ') { isFull = false; break; }
-        }
-        if (isFull) {
+        if (Rules::rowFull<StandardBoard>(board, i)) {
             if (cleared < 4) {
                 clearedLines[cleared] = i;
             }
             cleared++;
-            Audio::playClear();
 
-            for (int j = 1; j < W - 1; j++) {
-                sf::Color color = getColor(board[i][j]);
-/** Process playClear */
-                UI::addParticles(STATS_W + j * TILE_SIZE + TILE_SIZE/2,
-                                i * TILE_SIZE + TILE_SIZE/2, color, 5);
-            }
+            if (effectsEnabled) {
+                Audio::playClear();
 
-            for (int k = i; k > 0; k--) {
                 for (int j = 1; j < W - 1; j++) {
-                    board[k][j] = (k != 1) ? board[k - 1][j] : ' ';
+                    sf::Color color = getColor(board[i][j]);
+/** Process playClear */
+                    Render::queueParticles(STATS_W + j * TILE_SIZE + TILE_SIZE/2,
+                                           i * TILE_SIZE + TILE_SIZE/2, color, 5);
                 }
             }
+
+            // Every row from the top down to the cleared one moves, so
+            // their cells leave the hash and re-enter at the new position.
+            boardHash ^= Zobrist::hashRows(board, 0, i + 1);
+            Rules::removeRow<StandardBoard>(board, i);
+            boardHash ^= Zobrist::hashRows(board, 0, i + 1);
             i++;
         }
     }
 
-    if (cleared > 0) {
-        UI::startLineClearAnim(clearedLines, cleared);
+    if (cleared > 0 && effectsEnabled) {
+        Render::queueLineClear(clearedLines, cleared);
     }
 
     return cleared;
 }
 
-/** Reset all game variables for new game */
+/** Reset all game variables for new game with a fresh random seed */
 void resetGame() {
+    resetGame(std::random_device{}() ^
+              static_cast<unsigned>(std::chrono::steady_clock::now().time_since_epoch().count()));
+}
+
+/** Reset all game variables for a new game whose piece order follows seed */
+void resetGame(unsigned seed) {
+    if (effectsEnabled && resultsEnabled) Telemetry::beginSession();
     initBoard();
     delete currentPiece;
     delete nextPiece;
@@ -345,6 +368,13 @@ void resetGame() {
         delete holdPiece;
         holdPiece = nullptr;
     }
+    gameSeed = seed;
+    bagRng.seed(gameSeed);
+    for (int i = 0; i < 7; i++) pieceBag[i] = i;
+    bagIndex = 7;
+    garbageRng.seed(gameSeed ^ 0x9E3779B9u);
+    pendingGarbage = 0;
+    garbageSent = 0;
     currentPiece = createRandomPiece();
     nextPiece = createRandomPiece();
     for (int i = 0; i < 4; i++) {
@@ -355,6 +385,7 @@ void resetGame() {
     baseDelay = getBaseDelayForDifficulty();
     gameDelay = baseDelay;
     isGameOver = false;
+    gameOverRank = 0;
     gScore = 0;
     gLines = 0;
     gLevel = 0;
@@ -368,15 +399,215 @@ void resetGame() {
     for (int i = 0; i < 7; i++) pieceCount[i] = 0;
     dasTimer = 0.f;
     arrTimer = 0.f;
+    softDropTimer = 0.f;
     leftHeld = false;
     rightHeld = false;
     downHeld = false;
+    gravityTimer = 0.f;
+    blockInput = false;
     lockTimer = 0.f;
     lockMoves = 0;
     onGround = false;
     lastMoveWasRotate = false;
     backToBackActive = false;
     tSpinCount = 0;
+
+    if (gameMode == GameMode::PRACTICE) {
+        Practice::reset();
+        Practice::capture();
+    }
+    if (effectsEnabled && resultsEnabled) Replay::gameStarted();
+}
+
+/** Capture a piece slot by type, shape and rotation */
+static PieceState savePiece(const Piece* piece) {
+    PieceState state = {};
+    state.type = -1;
+    if (!piece) return state;
+
+    std::memcpy(state.shape, piece->shape, sizeof(state.shape));
+    for (int i = 0; i < 16 && state.type < 0; i++) {
+        if (state.shape[i / 4][i % 4] != ' ') state.type = static_cast<std::int8_t>(getPieceIndex(state.shape[i / 4][i % 4]));
+    }
+    if (const TPiece* t = dynamic_cast<const TPiece*>(piece)) {
+        state.rotationState = static_cast<std::int8_t>(t->rotationState);
+    }
+    return state;
+}
+
+/** Restore a piece slot, reusing the existing object when the type matches */
+static void restorePiece(Piece*& piece, const PieceState& state) {
+    if (state.type < 0) {
+        delete piece;
+        piece = nullptr;
+        return;
+    }
+    if (!piece || savePiece(piece).type != state.type) {
+        delete piece;
+        piece = createPiece(state.type);
+    }
+    std::memcpy(piece->shape, state.shape, sizeof(state.shape));
+    if (TPiece* t = dynamic_cast<TPiece*>(piece)) {
+        t->rotationState = state.rotationState;
+    }
+}
+
+/** Spawn-orientation state for a piece type, or an empty slot for -1 */
+PieceState makePieceState(int pieceType) {
+    if (pieceType < 0) return savePiece(nullptr);
+    Piece* piece = createPiece(pieceType);
+    PieceState state = savePiece(piece);
+    delete piece;
+    return state;
+}
+
+/** Copy the whole simulation state into snap */
+void saveSnapshot(GameSnapshot& snap) {
+    std::memcpy(snap.board, board, sizeof(board));
+    snap.current = savePiece(currentPiece);
+    snap.next = savePiece(nextPiece);
+    for (int i = 0; i < 4; i++) snap.queue[i] = savePiece(nextQueue[i]);
+    snap.hold = savePiece(holdPiece);
+    snap.x = x;
+    snap.y = y;
+    snap.gameDelay = gameDelay;
+    snap.baseDelay = baseDelay;
+    snap.isGameOver = isGameOver;
+    snap.canHold = canHold;
+    snap.gScore = gScore;
+    snap.gLines = gLines;
+    snap.gLevel = gLevel;
+    snap.currentLevel = currentLevel;
+    snap.comboCount = comboCount;
+    snap.lastClearLines = lastClearLines;
+    snap.lastMoveWasRotate = lastMoveWasRotate;
+    snap.backToBackActive = backToBackActive;
+    snap.tSpinCount = tSpinCount;
+    snap.tetrisCount = tetrisCount;
+    snap.totalPieces = totalPieces;
+    std::memcpy(snap.pieceCount, pieceCount, sizeof(pieceCount));
+    snap.playTime = playTime;
+    std::memcpy(snap.pieceBag, pieceBag, sizeof(pieceBag));
+    snap.bagIndex = bagIndex;
+    snap.bagRng = bagRng;
+    snap.gameSeed = gameSeed;
+    snap.dasTimer = dasTimer;
+    snap.arrTimer = arrTimer;
+    snap.softDropTimer = softDropTimer;
+    snap.leftHeld = leftHeld;
+    snap.rightHeld = rightHeld;
+    snap.downHeld = downHeld;
+    snap.dasDelay = DAS_DELAY;
+    snap.arrDelay = ARR_DELAY;
+    snap.instantSoftDrop = instantSoftDrop;
+    snap.lockTimer = lockTimer;
+    snap.lockMoves = lockMoves;
+    snap.onGround = onGround;
+    snap.gravityTimer = gravityTimer;
+    snap.blockInput = blockInput;
+    snap.pendingGarbage = pendingGarbage;
+    snap.garbageSent = garbageSent;
+    snap.garbageRng = garbageRng;
+}
+
+/** Make snap the live simulation state */
+void restoreSnapshot(const GameSnapshot& snap) {
+    std::memcpy(board, snap.board, sizeof(board));
+    boardHash = Zobrist::hashBoard(board);
+    restorePiece(currentPiece, snap.current);
+    restorePiece(nextPiece, snap.next);
+    for (int i = 0; i < 4; i++) restorePiece(nextQueue[i], snap.queue[i]);
+    restorePiece(holdPiece, snap.hold);
+    x = snap.x;
+    y = snap.y;
+    gameDelay = snap.gameDelay;
+    baseDelay = snap.baseDelay;
+    isGameOver = snap.isGameOver;
+    canHold = snap.canHold;
+    gScore = snap.gScore;
+    gLines = snap.gLines;
+    gLevel = snap.gLevel;
+    currentLevel = snap.currentLevel;
+    comboCount = snap.comboCount;
+    lastClearLines = snap.lastClearLines;
+    lastMoveWasRotate = snap.lastMoveWasRotate;
+    backToBackActive = snap.backToBackActive;
+    tSpinCount = snap.tSpinCount;
+    tetrisCount = snap.tetrisCount;
+    totalPieces = snap.totalPieces;
+    std::memcpy(pieceCount, snap.pieceCount, sizeof(pieceCount));
+    playTime = snap.playTime;
+    std::memcpy(pieceBag, snap.pieceBag, sizeof(pieceBag));
+    bagIndex = snap.bagIndex;
+    bagRng = snap.bagRng;
+    gameSeed = snap.gameSeed;
+    dasTimer = snap.dasTimer;
+    arrTimer = snap.arrTimer;
+    softDropTimer = snap.softDropTimer;
+    leftHeld = snap.leftHeld;
+    rightHeld = snap.rightHeld;
+    downHeld = snap.downHeld;
+    DAS_DELAY = snap.dasDelay;
+    ARR_DELAY = snap.arrDelay;
+    instantSoftDrop = snap.instantSoftDrop;
+    lockTimer = snap.lockTimer;
+    lockMoves = snap.lockMoves;
+    onGround = snap.onGround;
+    gravityTimer = snap.gravityTimer;
+    blockInput = snap.blockInput;
+    pendingGarbage = snap.pendingGarbage;
+    garbageSent = snap.garbageSent;
+    garbageRng = snap.garbageRng;
+}
+
+/** Copy the calling thread's settings, high score and last rank into snap */
+void saveSettingsSnapshot(SettingsSnapshot& snap) {
+    snap.musicVolume = musicVolume;
+    snap.sfxVolume = sfxVolume;
+    snap.brightness = brightness;
+    snap.ghostPieceEnabled = ghostPieceEnabled;
+    snap.instantSoftDrop = instantSoftDrop;
+    snap.dasDelay = DAS_DELAY;
+    snap.arrDelay = ARR_DELAY;
+    snap.difficulty = difficulty;
+    snap.gameMode = gameMode;
+    snap.highScore = highScore;
+    snap.gameOverRank = gameOverRank;
+}
+
+/** Make snap the calling thread's settings */
+void restoreSettingsSnapshot(const SettingsSnapshot& snap) {
+    musicVolume = snap.musicVolume;
+    sfxVolume = snap.sfxVolume;
+    brightness = snap.brightness;
+    ghostPieceEnabled = snap.ghostPieceEnabled;
+    instantSoftDrop = snap.instantSoftDrop;
+    DAS_DELAY = snap.dasDelay;
+    ARR_DELAY = snap.arrDelay;
+    difficulty = snap.difficulty;
+    gameMode = snap.gameMode;
+    highScore = snap.highScore;
+    gameOverRank = snap.gameOverRank;
+}
+
+/** FNV-1a over the fields two peers must agree on; used to spot desyncs */
+std::uint32_t snapshotChecksum(const GameSnapshot& snap) {
+    std::uint32_t hash = 2166136261u;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; i++) hash = (hash ^ bytes[i]) * 16777619u;
+    };
+    const PieceState* pieces[] = {&snap.current, &snap.next, &snap.queue[0], &snap.queue[1],
+                                  &snap.queue[2], &snap.queue[3], &snap.hold};
+    for (const PieceState* piece : pieces) {
+        mix(&piece->type, sizeof(piece->type));
+        mix(piece->shape, sizeof(piece->shape));
+    }
+    const int ints[] = {snap.x, snap.y, snap.gScore, snap.gLines, snap.totalPieces, snap.bagIndex,
+                        snap.pendingGarbage, snap.garbageSent, snap.isGameOver ? 1 : 0};
+    mix(snap.board, sizeof(snap.board));
+    mix(ints, sizeof(ints));
+    return hash;
 }
 
 /** Swap current piece with held piece */
@@ -463,10 +694,319 @@ bool isTSpin() {
 }
 
 bool isPerfectClear() {
-    for (int i = 1; i < H - 1; i++) {
-        for (int j = 1; j < W - 1; j++) {
-            if (board[i][j] != ' ') return false;
+    return Rules::perfectClear<StandardBoard>(board);
+}
+
+/** Push count garbage rows (one shared hole) up from the floor */
+void addGarbageRows(int count) {
+    count = std::min(count, StandardBoard::ROWS);
+    if (count <= 0) return;
+
+    int hole = 1 + static_cast<int>(garbageRng() % StandardBoard::COLS);
+    if (Rules::pushGarbage<StandardBoard>(board, count, hole)) isGameOver = true;
+    boardHash = Zobrist::hashBoard(board);
+}
+
+/** Versus: clears cancel incoming garbage first, the rest is sent; a piece that clears nothing takes the queue */
+static void exchangeGarbage(int cleared, bool tSpin) {
+    if (cleared > 0) {
+        int attack = tSpin ? cleared * 2 : (cleared == 4 ? 4 : cleared - 1);
+        if (isPerfectClear()) attack += 10;
+        int cancel = std::min(attack, pendingGarbage);
+        pendingGarbage -= cancel;
+        garbageSent += attack - cancel;
+    } else if (pendingGarbage > 0) {
+        addGarbageRows(pendingGarbage);
+        pendingGarbage = 0;
+    }
+}
+
+/** Lock the current piece, clear lines and spawn the next one */
+void lockPiece() {
+    blockInput = false;
+
+    if (currentPiece && effectsEnabled) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                if (currentPiece->shape[i][j] != ' ') {
+                    sf::Color c = getColor(currentPiece->shape[i][j]);
+                    Render::queueParticles(STATS_W + (x + j) * TILE_SIZE + TILE_SIZE/2,
+                                           (y + i) * TILE_SIZE + TILE_SIZE/2, c, 3);
+                }
+            }
         }
     }
+
+    block2Board();
+    if (effectsEnabled) Audio::playLand();
+    totalPieces++;
+
+    int pieceIdx = -1;
+    if (currentPiece) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                if (currentPiece->shape[i][j] != ' ') {
+                    pieceIdx = getPieceIndex(currentPiece->shape[i][j]);
+                    if (pieceIdx >= 0) pieceCount[pieceIdx]++;
+                    goto counted;
+                }
+            }
+        }
+        counted:;
+    }
+
+    int tSpinsBefore = tSpinCount;
+    int cleared = removeLine();
+    applyLineClearScore(cleared);
+    bool tSpin = tSpinCount > tSpinsBefore;
+
+    if (gameMode == GameMode::VERSUS) {
+        exchangeGarbage(cleared, tSpin);
+    }
+
+    Telemetry::PieceSample sample;
+    sample.lockTime = playTime;
+    sample.piece = static_cast<std::uint8_t>(pieceIdx);
+    sample.x = static_cast<std::int8_t>(x);
+    sample.y = static_cast<std::int8_t>(y);
+    sample.lines = static_cast<std::uint8_t>(cleared);
+    sample.tSpin = tSpin;
+    sample.combo = static_cast<std::uint16_t>(comboCount);
+    sample.backToBack = backToBackActive;
+    sample.stackHeight = static_cast<std::uint8_t>(getStackHeight());
+    sample.held = !canHold;
+    if (effectsEnabled && resultsEnabled) Telemetry::recordPiece(sample);
+
+    delete currentPiece;
+    currentPiece = nextPiece;
+    nextPiece = nextQueue[0];
+    for (int i = 0; i < 3; i++) {
+        nextQueue[i] = nextQueue[i + 1];
+    }
+    nextQueue[3] = createRandomPiece();
+
+    x = 4;
+    y = 0;
+    canHold = true;
+    onGround = false;
+    lockTimer = 0.f;
+    lockMoves = 0;
+
+    if (isGameOver || !canMove(0, 0)) {
+        isGameOver = true;
+        if (effectsEnabled) {
+            // A practice game can be undone past its top-out, so it is
+            // neither ranked nor closed here.
+            if (gameMode != GameMode::PRACTICE && resultsEnabled) {
+                saveHighScore();
+                recordFinishedGame();
+                Telemetry::endSession();
+                Replay::gameFinished();
+            }
+            Audio::stopTheme();
+            Audio::playGameOver();
+        }
+    }
+    else if (gameMode == GameMode::PRACTICE) {
+        Practice::capture();
+    }
+}
+
+/** Apply a key transition from the input sampler */
+void onGameKey(GameKey key, bool pressed) {
+    if (isGameOver) return;
+    Replay::recordKey(key, pressed);
+
+    if (key == GameKey::UNDO) {
+        if (gameMode == GameMode::PRACTICE) Practice::setRewinding(pressed);
+        return;
+    }
+
+    if (!pressed) {
+        if (key == GameKey::LEFT) leftHeld = false;
+        if (key == GameKey::RIGHT) rightHeld = false;
+        if (key == GameKey::DOWN) downHeld = false;
+        return;
+    }
+
+    if (!blockInput) {
+        if (key == GameKey::LEFT) {
+            if (canMove(-1, 0)) {
+                x--;
+                if (onGround) resetLockDelay();
+            }
+            leftHeld = true;
+            dasTimer = 0.f;
+            arrTimer = 0.f;
+            softDropTimer = 0.f;
+            lastMoveWasRotate = false;
+        }
+        if (key == GameKey::RIGHT) {
+            if (canMove(1, 0)) {
+                x++;
+                if (onGround) resetLockDelay();
+            }
+            rightHeld = true;
+            dasTimer = 0.f;
+            arrTimer = 0.f;
+            softDropTimer = 0.f;
+            lastMoveWasRotate = false;
+        }
+        if (key == GameKey::DOWN) {
+            if (instantSoftDrop) {
+                int dropDist = getGhostY() - y;
+                y += dropDist;
+                gScore += dropDist;
+            } else if (canMove(0, 1)) {
+                y++;
+                gScore += 1;
+            }
+            downHeld = true;
+            dasTimer = 0.f;
+            arrTimer = 0.f;
+            softDropTimer = 0.f;
+            lastMoveWasRotate = false;
+        }
+        if (key == GameKey::ROTATE && currentPiece) {
+            currentPiece->rotate(x, y);
+            if (onGround) resetLockDelay();
+            lastMoveWasRotate = true;
+        }
+        if (key == GameKey::HARD_DROP) {
+            int dropDist = getGhostY() - y;
+            y = getGhostY();
+            gScore += dropDist * 2;
+            blockInput = true;
+        }
+    }
+
+    if (key == GameKey::HOLD) {
+        swapHold();
+        blockInput = false;
+    }
+}
+
+/** Move one cell sideways for every held direction; false once that leaves the piece where it was */
+static bool shiftStep() {
+    int startX = x;
+    if (leftHeld && canMove(-1, 0)) {
+        x--;
+        if (onGround) resetLockDelay();
+        lastMoveWasRotate = false;
+    }
+    if (rightHeld && canMove(1, 0)) {
+        x++;
+        if (onGround) resetLockDelay();
+        lastMoveWasRotate = false;
+    }
+    return x != startX;
+}
+
+/** Instant shift: jump straight to the wall in the held direction */
+static void shiftToWall() {
+    int dir = (rightHeld ? 1 : 0) - (leftHeld ? 1 : 0);
+    if (dir == 0) return;
+
+    int dist = getShiftDistance(dir);
+    if (dist == 0) return;
+    x += dist * dir;
+    if (onGround) resetLockDelay();
+    lastMoveWasRotate = false;
+}
+
+/** Instant soft drop: land without locking, scoring one point per cell */
+static void softDropToFloor() {
+    int dropDist = getGhostY() - y;
+    if (dropDist == 0) return;
+    y += dropDist;
+    gScore += dropDist;
+    lastMoveWasRotate = false;
+}
+
+/** Move one cell down for a held soft drop */
+static bool softDropStep() {
+    if (!canMove(0, 1)) return false;
+    y++;
+    gScore += 1;
+    lastMoveWasRotate = false;
     return true;
 }
+
+/** Run DAS/ARR for exactly dt seconds, firing every repeat that falls inside */
+static void advanceAutoRepeat(float dt) {
+    if (!leftHeld && !rightHeld && !downHeld) return;
+
+    if (downHeld && instantSoftDrop) {
+        softDropToFloor();
+    }
+
+    float charged = dasTimer + dt - DAS_DELAY;
+    dasTimer = std::min(dasTimer + dt, DAS_DELAY);
+    if (charged < 0.f) return;
+    charged = std::min(charged, dt);
+
+    if (leftHeld || rightHeld) {
+        if (ARR_DELAY <= 0.f) {
+            shiftToWall();
+        } else {
+            arrTimer += charged;
+            while (arrTimer >= ARR_DELAY) {
+                arrTimer -= ARR_DELAY;
+                if (!shiftStep()) {
+                    arrTimer = 0.f;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (downHeld && !instantSoftDrop) {
+        float interval = std::max(ARR_DELAY, SOFT_DROP_INTERVAL);
+        softDropTimer += charged;
+        while (softDropTimer >= interval) {
+            softDropTimer -= interval;
+            if (!softDropStep()) {
+                softDropTimer = 0.f;
+                break;
+            }
+        }
+    }
+}
+
+/** Advance auto-repeat, lock delay and gravity by dt seconds */
+void advanceGame(float dt) {
+    if (isGameOver || dt < 0.f) return;
+    Replay::recordAdvance(dt);
+
+    if (gameMode == GameMode::PRACTICE) Practice::advance(dt);
+    playTime += dt;
+
+    if (!blockInput) {
+        advanceAutoRepeat(dt);
+    }
+
+    bool canMoveDown = canMove(0, 1);
+    if (!canMoveDown) {
+        if (!onGround) {
+            onGround = true;
+            lockTimer = 0.f;
+            lockMoves = 0;
+        }
+        lockTimer += dt;
+
+        if (lockTimer >= LOCK_DELAY || lockMoves >= MAX_LOCK_MOVES) {
+            lockPiece();
+        }
+    } else {
+        onGround = false;
+        lockTimer = 0.f;
+    }
+
+    gravityTimer += dt;
+    if (gravityTimer >= gameDelay) {
+        if (canMoveDown) {
+            y++;
+        }
+        gravityTimer = 0.f;
+    }
+}
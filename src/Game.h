@@ -7,68 +7,154 @@
 #pragma once
 #include "Config.h"
 #include "Piece.h"
+#include <cstdint>
+#include <random>
+#include <string>
 
-extern char board[H][W];
+// The simulation state is thread_local: each thread that calls resetGame
+// owns a separate game, which lets the tuner run headless games on every
+// core. The settings the UI shows are thread_local too, so the render
+// thread draws from its own copy; only effectsEnabled, resultsEnabled and
+// playerName are shared between threads. resultsEnabled decides whether
+// an effects game also counts: telemetry, high score, leaderboard and
+// auto-recorded replays.
+extern thread_local char board[H][W];
 
 
 // Game state management
-extern int x, y;
-extern float gameDelay;
-extern float baseDelay;
-extern bool isGameOver;
-
-extern int gScore;
-extern int gLines;
-extern int gLevel;
-extern int currentLevel;
-extern int highScore;
-
-extern int comboCount;
-extern int lastClearLines;
-
-extern bool lastMoveWasRotate;
-extern bool backToBackActive;
-extern int tSpinCount;
-
-extern float playTime;
-extern int tetrisCount;
-extern int totalPieces;
-extern int pieceCount[7];
-
-extern Piece* currentPiece;
-extern Piece* nextPiece;
-extern Piece* nextQueue[4];
-extern Piece* holdPiece;
-extern bool canHold;
-
-extern Difficulty difficulty;
-
-extern int pieceBag[7];
-extern int bagIndex;
-
-extern float dasTimer;
-extern float arrTimer;
-extern bool leftHeld;
-extern bool rightHeld;
-extern bool downHeld;
-extern float DAS_DELAY;
-extern float ARR_DELAY;
-
-extern float lockTimer;
-extern int lockMoves;
-extern bool onGround;
+extern thread_local int x, y;
+extern thread_local float gameDelay;
+extern thread_local float baseDelay;
+extern thread_local bool isGameOver;
+
+extern thread_local int gScore;
+extern thread_local int gLines;
+extern thread_local int gLevel;
+extern thread_local int currentLevel;
+extern thread_local int highScore;
+
+extern thread_local int comboCount;
+extern thread_local int lastClearLines;
+
+extern thread_local bool lastMoveWasRotate;
+extern thread_local bool backToBackActive;
+extern thread_local int tSpinCount;
+
+extern thread_local float playTime;
+extern thread_local int tetrisCount;
+extern thread_local int totalPieces;
+extern thread_local int pieceCount[7];
+
+extern thread_local std::uint64_t boardHash;
+extern thread_local Piece* currentPiece;
+extern thread_local Piece* nextPiece;
+extern thread_local Piece* nextQueue[4];
+extern thread_local Piece* holdPiece;
+extern thread_local bool canHold;
+
+extern thread_local Difficulty difficulty;
+extern thread_local GameMode gameMode;
+
+extern thread_local int pieceBag[7];
+extern thread_local int bagIndex;
+extern thread_local std::minstd_rand bagRng;
+extern thread_local unsigned gameSeed;
+extern thread_local int gameOverRank;
+
+extern thread_local float dasTimer;
+extern thread_local float arrTimer;
+extern thread_local float softDropTimer;
+extern thread_local bool leftHeld;
+extern thread_local bool rightHeld;
+extern thread_local bool downHeld;
+extern thread_local float DAS_DELAY;
+extern thread_local float ARR_DELAY;
+
+extern thread_local float lockTimer;
+extern thread_local int lockMoves;
+extern thread_local bool onGround;
 const float LOCK_DELAY = 0.5f;
 const int MAX_LOCK_MOVES = 15;
-
-extern float musicVolume;
-extern float sfxVolume;
-extern float brightness;
-extern bool ghostPieceEnabled;
+const float SOFT_DROP_INTERVAL = 1.f / TARGET_FPS;
+
+extern thread_local float gravityTimer;
+extern thread_local bool blockInput;
+
+extern thread_local int pendingGarbage;
+extern thread_local int garbageSent;
+extern thread_local std::minstd_rand garbageRng;
+extern bool effectsEnabled;
+extern bool resultsEnabled;
+
+extern thread_local float musicVolume;
+extern thread_local float sfxVolume;
+extern thread_local float brightness;
+extern thread_local bool ghostPieceEnabled;
+extern thread_local bool instantSoftDrop;
+extern std::string playerName;
+
+// Everything the simulation reads or writes, flattened into one POD so a
+// whole game can be saved, restored or stepped in another player's slot
+// without touching the heap (pieces are stored by type, shape and pose).
+struct PieceState {
+    std::int8_t type;
+    std::int8_t rotationState;
+    char shape[4][4];
+};
+
+struct GameSnapshot {
+    char board[H][W];
+    PieceState current, next, queue[4], hold;
+    int x, y;
+    float gameDelay, baseDelay;
+    bool isGameOver, canHold;
+    int gScore, gLines, gLevel, currentLevel;
+    int comboCount, lastClearLines;
+    bool lastMoveWasRotate, backToBackActive;
+    int tSpinCount, tetrisCount, totalPieces;
+    int pieceCount[7];
+    float playTime;
+    int pieceBag[7];
+    int bagIndex;
+    std::minstd_rand bagRng;
+    unsigned gameSeed;
+    float dasTimer, arrTimer, softDropTimer;
+    bool leftHeld, rightHeld, downHeld;
+    float dasDelay, arrDelay;
+    bool instantSoftDrop;
+    float lockTimer;
+    int lockMoves;
+    bool onGround;
+    float gravityTimer;
+    bool blockInput;
+    int pendingGarbage, garbageSent;
+    std::minstd_rand garbageRng;
+};
+
+// The settings and per-game results the screens show besides the
+// simulation itself, copied between threads as one value.
+struct SettingsSnapshot {
+    float musicVolume, sfxVolume, brightness;
+    bool ghostPieceEnabled, instantSoftDrop;
+    float dasDelay, arrDelay;
+    Difficulty difficulty;
+    GameMode gameMode;
+    int highScore, gameOverRank;
+};
+
+PieceState makePieceState(int pieceType);
+void saveSnapshot(GameSnapshot& snap);
+void restoreSnapshot(const GameSnapshot& snap);
+void saveSettingsSnapshot(SettingsSnapshot& snap);
+void restoreSettingsSnapshot(const SettingsSnapshot& snap);
+std::uint32_t snapshotChecksum(const GameSnapshot& snap);
 
 void initBoard();
 void block2Board();
 bool canMove(int dx, int dy);
 int getGhostY();
+int getShiftDistance(int dir);
+int getStackHeight();
 void SpeedIncrement();
 void applyLineClearScore(int cleared);
 
@@ -76,9 +162,12 @@ void applyLineClearScore(int cleared);
 // Game functions
 int removeLine();
 void resetGame();
+void resetGame(unsigned seed);
+void addGarbageRows(int count);
 void swapHold();
 void loadHighScore();
 void saveHighScore();
+void recordFinishedGame();
 void loadSettings();
 void saveSettings();
 float getBaseDelayForDifficulty();
@@ -86,3 +175,6 @@ int getPieceIndex(char c);
 void resetLockDelay();
 bool isTSpin();
 bool isPerfectClear();
+void lockPiece();
+void onGameKey(GameKey key, bool pressed);
+void advanceGame(float dt);
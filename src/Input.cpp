@@ -0,0 +1,83 @@
+/*
+ * Tetris Game - High-rate keyboard sampler implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Input.h"
+#include "SpscQueue.h"
+#include <SFML/System.hpp>
+#include <SFML/Window.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace Input {
+
+    static const int POLL_INTERVAL_US = 1000;
+    static const int IDLE_INTERVAL_MS = 20;
+
+    static const sf::Keyboard::Key keyMap[(int)GameKey::COUNT] = {
+        sf::Keyboard::Key::Left,
+        sf::Keyboard::Key::Right,
+        sf::Keyboard::Key::Down,
+        sf::Keyboard::Key::Up,
+        sf::Keyboard::Key::Space,
+        sf::Keyboard::Key::C,
+        sf::Keyboard::Key::Z,
+    };
+
+    static SpscQueue<KeyEvent, 256> events;
+    static std::atomic<bool> running{false};
+    static std::atomic<bool> active{false};
+    static std::thread sampler;
+    static const auto startTime = std::chrono::steady_clock::now();
+
+/** Seconds since startup on the clock shared by sampler and simulation */
+    double now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+/** Sample the keyboard at ~1 kHz and queue every transition with its time */
+    static void sampleLoop() {
+        bool wasDown[(int)GameKey::COUNT] = {};
+
+        while (running.load(std::memory_order_relaxed)) {
+            if (!active.load(std::memory_order_relaxed)) {
+                for (bool& down : wasDown) down = false;
+                sf::sleep(sf::milliseconds(IDLE_INTERVAL_MS));
+                continue;
+            }
+
+            for (int k = 0; k < (int)GameKey::COUNT; k++) {
+                bool down = sf::Keyboard::isKeyPressed(keyMap[k]);
+                if (down != wasDown[k]) {
+                    wasDown[k] = down;
+                    events.push({static_cast<GameKey>(k), down, now()});
+                }
+            }
+            sf::sleep(sf::microseconds(POLL_INTERVAL_US));
+        }
+    }
+
+/** Start the sampler thread */
+    void start() {
+        if (running.exchange(true)) return;
+        sampler = std::thread(sampleLoop);
+    }
+
+/** Stop and join the sampler thread */
+    void stop() {
+        if (!running.exchange(false)) return;
+        if (sampler.joinable()) sampler.join();
+    }
+
+    void setActive(bool isActive) {
+        active.store(isActive, std::memory_order_relaxed);
+    }
+
+/** Pop the next key transition, oldest first */
+    bool poll(KeyEvent& event) {
+        return events.pop(event);
+    }
+}
@@ -0,0 +1,25 @@
+/*
+ * Tetris Game - High-rate keyboard sampler
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+
+namespace Input {
+    struct KeyEvent {
+        GameKey key;
+        bool pressed;
+        double time;
+    };
+
+    void start();
+    void stop();
+
+// Sampling only runs while a game is in progress and the window has focus
+    void setActive(bool active);
+
+    bool poll(KeyEvent& event);
+    double now();
+}
@@ -0,0 +1,234 @@
+/*
+ * Tetris Game - Work-stealing job system implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Jobs.h"
+#include "AllocStats.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Jobs {
+
+    static const int MAX_DEQUES = 64;
+    static const std::int64_t INITIAL_CAPACITY = 256;
+    static const int SPINS_BEFORE_SLEEP = 64;
+
+    struct Task {
+        std::function<void()> work;
+        Group* group;
+    };
+
+    // Ring of task pointers; a full ring is replaced by one twice the size
+    // and the old one is kept until stop(), since a thief may still read it.
+    struct Ring {
+        std::int64_t capacity;
+        std::atomic<Task*>* slots;
+        Ring* retired;
+
+        explicit Ring(std::int64_t size) : capacity(size), slots(new std::atomic<Task*>[size]), retired(nullptr) {}
+        ~Ring() { delete[] slots; }
+
+        Task* get(std::int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, Task* task) { slots[i & (capacity - 1)].store(task, std::memory_order_relaxed); }
+    };
+
+    // Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for
+    // Weak Memory Models"): push/pop by the owner only, steal by anyone.
+    struct Deque {
+        alignas(64) std::atomic<std::int64_t> top{0};
+        alignas(64) std::atomic<std::int64_t> bottom{0};
+        std::atomic<Ring*> ring{new Ring(INITIAL_CAPACITY)};
+
+        ~Deque() {
+            for (Ring* r = ring.load(); r;) {
+                Ring* older = r->retired;
+                delete r;
+                r = older;
+            }
+        }
+
+        void push(Task* task) {
+            std::int64_t b = bottom.load(std::memory_order_relaxed);
+            std::int64_t t = top.load(std::memory_order_acquire);
+            Ring* r = ring.load(std::memory_order_relaxed);
+            if (b - t > r->capacity - 1) {
+                Ring* grown = new Ring(r->capacity * 2);
+                for (std::int64_t i = t; i < b; i++) grown->put(i, r->get(i));
+                grown->retired = r;
+                ring.store(grown, std::memory_order_release);
+                r = grown;
+            }
+            r->put(b, task);
+            bottom.store(b + 1, std::memory_order_release);
+        }
+
+        Task* pop() {
+            std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            Ring* r = ring.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top.load(std::memory_order_relaxed);
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            Task* task = r->get(b);
+            if (t == b) {
+                // Last task: race thieves for it through top.
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) task = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        Task* steal() {
+            std::int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b) return nullptr;
+            Task* task = ring.load(std::memory_order_acquire)->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+            return task;
+        }
+    };
+
+    // Deques are registered lock-free: a thread claims the next index and
+    // publishes its deque there. Thieves skip indices not yet published.
+    static std::atomic<Deque*> deques[MAX_DEQUES];
+    static std::atomic<int> dequeCount{0};
+    static std::atomic<unsigned> epoch{0};
+    thread_local Deque* localDeque = nullptr;
+    thread_local unsigned localEpoch = 0;
+
+    static std::vector<std::thread> workers;
+    static std::atomic<bool> running{false};
+    static std::atomic<int> queued{0};
+    static std::atomic<int> sleepers{0};
+    static std::mutex sleepMutex;
+    static std::condition_variable wake;
+
+/** The calling thread's deque, registered on first use; null when all slots are taken */
+    static Deque* ownDeque() {
+        unsigned now = epoch.load(std::memory_order_acquire);
+        if (localDeque && localEpoch == now) return localDeque;
+        localDeque = nullptr;
+        int index = dequeCount.fetch_add(1, std::memory_order_relaxed);
+        if (index >= MAX_DEQUES) return nullptr;
+        localDeque = new Deque();
+        localEpoch = now;
+        deques[index].store(localDeque, std::memory_order_release);
+        return localDeque;
+    }
+
+    static void execute(Task* task) {
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        task->work();
+        task->group->pending.fetch_sub(1, std::memory_order_release);
+        delete task;
+    }
+
+/** Pop local work first, then steal round-robin starting after our own slot */
+    static Task* findTask(Deque* own, unsigned seed) {
+        if (own) {
+            if (Task* task = own->pop()) return task;
+        }
+        int count = std::min(dequeCount.load(std::memory_order_acquire), MAX_DEQUES);
+        for (int i = 0; i < count; i++) {
+            Deque* victim = deques[(seed + i) % count].load(std::memory_order_acquire);
+            if (!victim || victim == own) continue;
+            if (Task* task = victim->steal()) return task;
+        }
+        return nullptr;
+    }
+
+    static void workerLoop(unsigned index) {
+        AllocStats::Scope scope(AllocStats::Subsystem::JOBS);
+        Deque* own = ownDeque();
+        int idle = 0;
+        while (running.load(std::memory_order_acquire)) {
+            if (Task* task = findTask(own, index)) {
+                execute(task);
+                idle = 0;
+                continue;
+            }
+            if (++idle < SPINS_BEFORE_SLEEP) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Submitters notify without the mutex, so a wakeup can slip in
+            // between the check and the wait; the timeout bounds that case.
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (queued.load(std::memory_order_seq_cst) == 0 && running.load()) {
+                wake.wait_for(lock, std::chrono::milliseconds(5));
+            }
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+        }
+    }
+
+    unsigned defaultWorkers() {
+        unsigned cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 1;
+    }
+
+/** Spawn the workers; the threads that submit and wait make up the rest */
+    void start(unsigned count) {
+        if (running.load()) return;
+        running.store(true);
+        for (unsigned i = 0; i < count; i++) workers.emplace_back(workerLoop, i);
+    }
+
+/** Join the workers and drop every deque; queued tasks must be finished first */
+    void stop() {
+        if (!running.load()) return;
+        running.store(false);
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+        workers.clear();
+
+        int count = std::min(dequeCount.load(), MAX_DEQUES);
+        for (int i = 0; i < count; i++) delete deques[i].exchange(nullptr);
+        dequeCount.store(0);
+        epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    unsigned workerCount() {
+        return static_cast<unsigned>(workers.size());
+    }
+
+    void run(Group& group, std::function<void()> task) {
+        Deque* own = running.load(std::memory_order_acquire) ? ownDeque() : nullptr;
+        if (!own) {
+            task();
+            return;
+        }
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        own->push(new Task{std::move(task), &group});
+        if (sleepers.load(std::memory_order_seq_cst) > 0) wake.notify_one();
+    }
+
+    bool done(const Group& group) {
+        return group.pending.load(std::memory_order_acquire) == 0;
+    }
+
+/** Help with queued work until every task of group has finished */
+    void wait(Group& group) {
+        Deque* own = running.load(std::memory_order_acquire) ? ownDeque() : nullptr;
+        unsigned seed = 0;
+        while (!done(group)) {
+            if (Task* task = findTask(own, seed++)) {
+                execute(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * Tetris Game - Work-stealing job system
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+// One pool of worker threads shared by every parallel workload. Each
+// thread that submits work (workers, the render thread, a tool's main
+// thread) gets its own Chase-Lev deque: the owner pushes and pops at the
+// bottom without locks, and idle workers steal the oldest task from the
+// top of someone else's deque. Submitting never takes a lock, so the
+// render thread can hand off work and poll done() without ever waiting.
+// wait() runs queued tasks on the calling thread until the group is done,
+// so groups can be nested inside tasks. Before start(), run() executes
+// tasks inline.
+namespace Jobs {
+    struct Group {
+        std::atomic<int> pending{0};
+    };
+
+    unsigned defaultWorkers();
+    void start(unsigned workers = defaultWorkers());
+    void stop();
+    unsigned workerCount();
+
+    void run(Group& group, std::function<void()> task);
+    bool done(const Group& group);
+    void wait(Group& group);
+
+    /** Run body(i) for every i in [begin, end), grain indices per task */
+    template <typename Body>
+    void parallelFor(int begin, int end, int grain, const Body& body) {
+        Group group;
+        grain = std::max(1, grain);
+        for (int first = begin; first < end; first += grain) {
+            int last = std::min(end, first + grain);
+            run(group, [first, last, &body] {
+                for (int i = first; i < last; i++) body(i);
+            });
+        }
+        wait(group);
+    }
+}
@@ -0,0 +1,201 @@
+/*
+ * Tetris Game - Local leaderboard store implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Leaderboard.h"
+#include "Persist.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Leaderboard {
+
+    static const char* LOG_PATH = "scores.log";
+    static const char* INDEX_PATH = "scores.idx";
+    static const std::uint32_t INDEX_VERSION = 1;
+    static const int TABLE_COUNT = DIFFICULTY_COUNT * static_cast<int>(GameMode::COUNT);
+
+    struct IndexHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t logSize;
+        std::uint32_t tableCount;
+        std::uint32_t topN;
+        std::uint32_t checksum;
+        std::uint32_t reserved;
+    };
+
+    static Table tables[TABLE_COUNT] = {};
+    static std::uint64_t logSize = 0;
+    static int sinceCheckpoint = 0;
+
+/** FNV-1a hash used to reject torn or corrupted entries */
+    static std::uint32_t hashBytes(const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    static std::uint32_t recordChecksum(const Record& record) {
+        return hashBytes(&record, offsetof(Record, checksum));
+    }
+
+    static int tableIndex(int difficulty, int mode) {
+        if (difficulty < 0 || difficulty >= DIFFICULTY_COUNT) return -1;
+        if (mode < 0 || mode >= static_cast<int>(GameMode::COUNT)) return -1;
+        return mode * DIFFICULTY_COUNT + difficulty;
+    }
+
+/** Insert into its table; returns the 1-based rank or 0 when outside the top N */
+    static int insert(const Record& record) {
+        int index = tableIndex(record.difficulty, record.mode);
+        if (index < 0) return 0;
+
+        Table& t = tables[index];
+        t.games++;
+
+        int pos = static_cast<int>(t.used);
+        while (pos > 0 && t.top[pos - 1].score < record.score) pos--;
+        if (pos >= TOP_N) return 0;
+
+        int last = (t.used < TOP_N) ? static_cast<int>(t.used) : TOP_N - 1;
+        for (int i = last; i > pos; i--) t.top[i] = t.top[i - 1];
+        t.top[pos] = record;
+        if (t.used < TOP_N) t.used++;
+        return pos + 1;
+    }
+
+/** Replay the whole records from offset on; corrupt ones are skipped and counted, and the valid ones kept */
+    static int replayLog(std::uint64_t offset, std::string& kept) {
+        std::ifstream file(LOG_PATH, std::ios::binary);
+        if (!file) return 0;
+        file.seekg(static_cast<std::streamoff>(offset));
+
+        int corrupt = 0;
+        Record record;
+        while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+            if (record.checksum != recordChecksum(record)) {
+                corrupt++;
+                continue;
+            }
+            insert(record);
+            kept.append(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+        return corrupt;
+    }
+
+/** Rewrite the log as its first prefix bytes followed by kept, dropping corrupt records */
+    static bool compactLog(std::uint64_t prefix, const std::string& kept) {
+        std::string bytes(static_cast<std::size_t>(prefix), '\0');
+        if (prefix > 0) {
+            std::ifstream file(LOG_PATH, std::ios::binary);
+            if (!file.read(&bytes[0], static_cast<std::streamsize>(prefix))) return false;
+        }
+        bytes += kept;
+        return Persist::writeAtomic(LOG_PATH, bytes);
+    }
+
+/** Read the checkpoint; false when it is missing, stale or from another layout */
+    static bool readIndex(std::uint64_t actualLogSize) {
+        std::ifstream file(INDEX_PATH, std::ios::binary);
+        if (!file) return false;
+
+        IndexHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+        if (std::memcmp(header.magic, "TIDX", 4) != 0 || header.version != INDEX_VERSION ||
+            header.tableCount != TABLE_COUNT || header.topN != TOP_N ||
+            header.logSize > actualLogSize || header.logSize % sizeof(Record) != 0) {
+            return false;
+        }
+
+        Table loaded[TABLE_COUNT];
+        if (!file.read(reinterpret_cast<char*>(loaded), sizeof(loaded))) return false;
+        if (header.checksum != hashBytes(loaded, sizeof(loaded))) return false;
+
+        std::memcpy(tables, loaded, sizeof(tables));
+        logSize = header.logSize;
+        return true;
+    }
+
+/** Queue a new checkpoint covering everything appended so far */
+    static void writeIndex() {
+        IndexHeader header = {};
+        std::memcpy(header.magic, "TIDX", 4);
+        header.version = INDEX_VERSION;
+        header.logSize = logSize;
+        header.tableCount = TABLE_COUNT;
+        header.topN = TOP_N;
+        header.checksum = hashBytes(tables, sizeof(tables));
+
+        std::string bytes(reinterpret_cast<const char*>(&header), sizeof(header));
+        bytes.append(reinterpret_cast<const char*>(tables), sizeof(tables));
+        Persist::writeFile(INDEX_PATH, bytes);
+        sinceCheckpoint = 0;
+    }
+
+/** Load the checkpoint and catch up on records appended after it */
+    void load() {
+        std::error_code ec;
+        std::uint64_t actualLogSize = std::filesystem::file_size(LOG_PATH, ec);
+        if (ec) actualLogSize = 0;
+
+        if (!readIndex(actualLogSize)) {
+            std::memset(tables, 0, sizeof(tables));
+            logSize = 0;
+        }
+
+        if (actualLogSize == logSize) return;
+
+        // A partial record can only be a torn final append and is trimmed.
+        // A bad checksum in a whole record is skipped rather than cut at,
+        // so the games after it survive, and the log is rewritten without
+        // the bad records once they are found.
+        std::string kept;
+        int corrupt = replayLog(logSize, kept);
+        std::uint64_t whole = actualLogSize - actualLogSize % sizeof(Record);
+        bool compacted = false;
+        if (corrupt > 0) {
+            std::fprintf(stderr, "Leaderboard: skipped %d corrupt records in %s\n", corrupt, LOG_PATH);
+            compacted = compactLog(logSize, kept);
+            if (!compacted) std::fprintf(stderr, "Leaderboard: could not compact %s\n", LOG_PATH);
+        }
+        if (compacted) {
+            whole = logSize + kept.size();
+        } else if (whole != actualLogSize) {
+            std::filesystem::resize_file(LOG_PATH, whole, ec);
+            if (ec) std::fprintf(stderr, "Leaderboard: could not trim torn tail of %s\n", LOG_PATH);
+        }
+        logSize = whole;
+        writeIndex();
+    }
+
+/** Append a finished game and return its rank within its table */
+    int submit(const Record& record) {
+        Record stored = record;
+        std::memset(stored.reserved, 0, sizeof(stored.reserved));
+        stored.checksum = recordChecksum(stored);
+
+        int rank = insert(stored);
+        Persist::appendFile(LOG_PATH, std::string(reinterpret_cast<const char*>(&stored), sizeof(stored)));
+        logSize += sizeof(stored);
+
+        if (++sinceCheckpoint >= CHECKPOINT_EVERY) writeIndex();
+        return rank;
+    }
+
+/** Top-N table and game count for one difficulty and mode; an empty table when either is out of range */
+    const Table& table(Difficulty difficulty, GameMode mode) {
+        static const Table empty = {};
+        int index = tableIndex(static_cast<int>(difficulty), static_cast<int>(mode));
+        return index < 0 ? empty : tables[index];
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Tetris Game - Local leaderboard store
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+#include <cstdint>
+
+// Every finished game is appended to scores.log as a fixed-size record.
+// scores.idx is a checkpoint of the top-N table for each difficulty and
+// mode plus the log length it covers, so startup reads the index and only
+// the records appended after it, not the whole history. A torn final
+// record is trimmed; whole records with a bad checksum are skipped and the
+// log is rewritten without them, keeping every game after them.
+namespace Leaderboard {
+    const int TOP_N = 10;
+    const int CHECKPOINT_EVERY = 16;
+
+    struct Record {
+        std::int64_t finishedAt;
+        std::int32_t score;
+        std::int32_t lines;
+        std::int32_t level;
+        std::uint32_t seed;
+        float playTime;
+        float ppm;
+        std::uint8_t difficulty;
+        std::uint8_t mode;
+        std::uint8_t reserved[2];
+        std::uint32_t checksum;
+    };
+    static_assert(sizeof(Record) == 40, "scores.log record layout changed");
+
+    struct Table {
+        std::uint32_t games;
+        std::uint32_t used;
+        Record top[TOP_N];
+    };
+
+    void load();
+    int submit(const Record& record);
+    const Table& table(Difficulty difficulty, GameMode mode);
+}
@@ -0,0 +1,286 @@
+/*
+ * Tetris Game - Minimal socket layer implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Net.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int socklen_t;
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace Net {
+
+/** Start Winsock once; a no-op elsewhere */
+    bool init() {
+#ifdef _WIN32
+        static bool started = false;
+        if (!started) {
+            WSADATA data;
+            if (WSAStartup(MAKEWORD(2, 2), &data) != 0) return false;
+            started = true;
+        }
+#endif
+        return true;
+    }
+
+/** Resolve "host" or "host:port" to an IPv4 address */
+    bool resolve(const std::string& hostPort, std::uint16_t defaultPort, Address& out) {
+        if (!init()) return false;
+
+        std::string host = hostPort;
+        std::uint16_t port = defaultPort;
+        std::size_t colon = hostPort.rfind(':');
+        if (colon != std::string::npos) {
+            host = hostPort.substr(0, colon);
+            port = static_cast<std::uint16_t>(std::atoi(hostPort.c_str() + colon + 1));
+        }
+
+        addrinfo hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* result = nullptr;
+        if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result) return false;
+
+        out.host = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
+        out.port = htons(port);
+        freeaddrinfo(result);
+        return true;
+    }
+
+    bool sameAddress(const Address& a, const Address& b) {
+        return a.host == b.host && a.port == b.port;
+    }
+
+    std::string toString(const Address& address) {
+        const unsigned char* ip = reinterpret_cast<const unsigned char*>(&address.host);
+        char text[32];
+        std::snprintf(text, sizeof(text), "%u.%u.%u.%u:%u", ip[0], ip[1], ip[2], ip[3], ntohs(address.port));
+        return text;
+    }
+
+    static void setNonBlocking(Socket handle) {
+#ifdef _WIN32
+        u_long nonBlocking = 1;
+        ioctlsocket(handle, FIONBIO, &nonBlocking);
+#else
+        fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    }
+
+    static bool wouldBlock() {
+#ifdef _WIN32
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+    }
+
+/** Per-connection options: no Nagle delay, and no SIGPIPE where MSG_NOSIGNAL is missing */
+    static void configureStream(Socket handle, bool tcp) {
+        int one = 1;
+        if (tcp) {
+            setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one), sizeof(one));
+        }
+#ifdef SO_NOSIGPIPE
+        setsockopt(handle, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        setNonBlocking(handle);
+    }
+
+#ifndef _WIN32
+/** Fill a sockaddr_un for "unix:/path"; false when the path does not fit */
+    static bool unixAddress(const std::string& endpoint, sockaddr_un& address) {
+        std::string path = endpoint.substr(5);
+        address = {};
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) return false;
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+        return true;
+    }
+#endif
+
+    static bool isUnixEndpoint(const std::string& endpoint) {
+        return endpoint.compare(0, 5, "unix:") == 0;
+    }
+
+/** Open a non-blocking UDP socket bound to port (0 picks any free port) */
+    Socket openUdp(std::uint16_t port) {
+        if (!init()) return INVALID_SOCKET_HANDLE;
+
+        Socket handle = static_cast<Socket>(::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+        if (handle == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+
+        sockaddr_in local = {};
+        local.sin_family = AF_INET;
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        local.sin_port = htons(port);
+        if (::bind(handle, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+            closeSocket(handle);
+            return INVALID_SOCKET_HANDLE;
+        }
+
+        setNonBlocking(handle);
+        return handle;
+    }
+
+    bool sendTo(Socket socket, const Address& to, const void* data, std::size_t size) {
+        sockaddr_in remote = {};
+        remote.sin_family = AF_INET;
+        remote.sin_addr.s_addr = to.host;
+        remote.sin_port = to.port;
+        return ::sendto(socket, static_cast<const char*>(data), static_cast<int>(size), 0,
+                        reinterpret_cast<sockaddr*>(&remote), sizeof(remote)) == static_cast<int>(size);
+    }
+
+/** Read one datagram; returns its size, or -1 when nothing is waiting */
+    int receiveFrom(Socket socket, Address& from, void* buffer, std::size_t capacity) {
+        sockaddr_in remote = {};
+        socklen_t length = sizeof(remote);
+        int received = static_cast<int>(::recvfrom(socket, static_cast<char*>(buffer), static_cast<int>(capacity), 0,
+                                                   reinterpret_cast<sockaddr*>(&remote), &length));
+        if (received < 0) return -1;
+        from.host = remote.sin_addr.s_addr;
+        from.port = remote.sin_port;
+        return received;
+    }
+
+/** Listen on a TCP port or Unix socket path; accepts are non-blocking */
+    Socket listenStream(const std::string& endpoint) {
+        if (!init()) return INVALID_SOCKET_HANDLE;
+
+        Socket handle = INVALID_SOCKET_HANDLE;
+        if (isUnixEndpoint(endpoint)) {
+#ifdef _WIN32
+            std::fprintf(stderr, "Net: unix sockets are not supported on Windows\n");
+            return INVALID_SOCKET_HANDLE;
+#else
+            sockaddr_un address;
+            if (!unixAddress(endpoint, address)) return INVALID_SOCKET_HANDLE;
+            ::unlink(address.sun_path);
+            handle = static_cast<Socket>(::socket(AF_UNIX, SOCK_STREAM, 0));
+            if (handle == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+            if (::bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                closeSocket(handle);
+                return INVALID_SOCKET_HANDLE;
+            }
+#endif
+        } else {
+            std::size_t colon = endpoint.rfind(':');
+            int port = std::atoi(endpoint.c_str() + (colon == std::string::npos ? 0 : colon + 1));
+            handle = static_cast<Socket>(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+            if (handle == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+
+            int one = 1;
+            setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&one), sizeof(one));
+            sockaddr_in local = {};
+            local.sin_family = AF_INET;
+            local.sin_addr.s_addr = htonl(INADDR_ANY);
+            local.sin_port = htons(static_cast<std::uint16_t>(port));
+            if (::bind(handle, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+                closeSocket(handle);
+                return INVALID_SOCKET_HANDLE;
+            }
+        }
+
+        if (::listen(handle, 16) != 0) {
+            closeSocket(handle);
+            return INVALID_SOCKET_HANDLE;
+        }
+        setNonBlocking(handle);
+        return handle;
+    }
+
+/** Accept one pending connection, or INVALID_SOCKET_HANDLE when none is waiting */
+    Socket acceptStream(Socket listener) {
+        sockaddr_storage remote;
+        socklen_t length = sizeof(remote);
+        Socket handle = static_cast<Socket>(::accept(listener, reinterpret_cast<sockaddr*>(&remote), &length));
+        if (handle == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+        configureStream(handle, remote.ss_family == AF_INET);
+        return handle;
+    }
+
+/** Connect (blocking) to a TCP or Unix endpoint, then switch to non-blocking */
+    Socket connectStream(const std::string& endpoint, std::uint16_t defaultPort) {
+        if (!init()) return INVALID_SOCKET_HANDLE;
+
+        Socket handle = INVALID_SOCKET_HANDLE;
+        bool tcp = !isUnixEndpoint(endpoint);
+        if (!tcp) {
+#ifdef _WIN32
+            return INVALID_SOCKET_HANDLE;
+#else
+            sockaddr_un address;
+            if (!unixAddress(endpoint, address)) return INVALID_SOCKET_HANDLE;
+            handle = static_cast<Socket>(::socket(AF_UNIX, SOCK_STREAM, 0));
+            if (handle == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+            if (::connect(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                closeSocket(handle);
+                return INVALID_SOCKET_HANDLE;
+            }
+#endif
+        } else {
+            Address target;
+            if (!resolve(endpoint, defaultPort, target)) return INVALID_SOCKET_HANDLE;
+            handle = static_cast<Socket>(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+            if (handle == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+
+            sockaddr_in remote = {};
+            remote.sin_family = AF_INET;
+            remote.sin_addr.s_addr = target.host;
+            remote.sin_port = target.port;
+            if (::connect(handle, reinterpret_cast<sockaddr*>(&remote), sizeof(remote)) != 0) {
+                closeSocket(handle);
+                return INVALID_SOCKET_HANDLE;
+            }
+        }
+        configureStream(handle, tcp);
+        return handle;
+    }
+
+/** Write what the socket takes now: bytes written, 0 when full, -1 when closed */
+    int sendStream(Socket socket, const void* data, std::size_t size) {
+        int sent = static_cast<int>(::send(socket, static_cast<const char*>(data), static_cast<int>(size), MSG_NOSIGNAL));
+        if (sent >= 0) return sent;
+        return wouldBlock() ? 0 : -1;
+    }
+
+/** Read what has arrived: bytes read, 0 when nothing is waiting, -1 when closed */
+    int receiveStream(Socket socket, void* buffer, std::size_t capacity) {
+        int received = static_cast<int>(::recv(socket, static_cast<char*>(buffer), static_cast<int>(capacity), 0));
+        if (received > 0) return received;
+        if (received == 0) return -1;
+        return wouldBlock() ? 0 : -1;
+    }
+
+    void closeSocket(Socket socket) {
+        if (socket == INVALID_SOCKET_HANDLE) return;
+#ifdef _WIN32
+        ::closesocket(socket);
+#else
+        ::close(static_cast<int>(socket));
+#endif
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ * Tetris Game - Minimal socket layer
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Thin non-blocking wrapper over BSD sockets / Winsock, shared by the game
+// and the tools so neither needs SFML's network module. Stream endpoints
+// are "port", "host:port", or "unix:/path" (POSIX only).
+namespace Net {
+    typedef std::intptr_t Socket;
+    const Socket INVALID_SOCKET_HANDLE = -1;
+
+    struct Address {
+        std::uint32_t host;
+        std::uint16_t port;
+    };
+
+    bool init();
+    bool resolve(const std::string& hostPort, std::uint16_t defaultPort, Address& out);
+    bool sameAddress(const Address& a, const Address& b);
+    std::string toString(const Address& address);
+
+    Socket openUdp(std::uint16_t port);
+    bool sendTo(Socket socket, const Address& to, const void* data, std::size_t size);
+    int receiveFrom(Socket socket, Address& from, void* buffer, std::size_t capacity);
+
+    Socket listenStream(const std::string& endpoint);
+    Socket acceptStream(Socket listener);
+    Socket connectStream(const std::string& endpoint, std::uint16_t defaultPort);
+    int sendStream(Socket socket, const void* data, std::size_t size);
+    int receiveStream(Socket socket, void* buffer, std::size_t capacity);
+
+    void closeSocket(Socket socket);
+}
@@ -0,0 +1,59 @@
+/*
+ * Tetris Game - Versus wire protocol
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstdint>
+
+// UDP datagrams between a game client and the relay (little-endian).
+// A client sends HELLO with its handling settings; once two clients are
+// waiting the relay sends each a START with the shared seed, its player
+// slot and the opponent's settings, then forwards INPUT packets between
+// them. Every INPUT repeats all unacknowledged inputs so a lost datagram
+// is covered by the next one.
+const std::uint16_t RELAY_PORT = 7777;
+const int INPUT_REDUNDANCY = 16;
+
+enum NetPacketType : std::uint8_t {
+    NET_HELLO = 1,
+    NET_START = 2,
+    NET_INPUT = 3,
+};
+
+struct HelloPacket {
+    std::uint8_t type;
+    std::uint8_t instantSoftDrop;
+    std::uint16_t reserved;
+    float dasDelay;
+    float arrDelay;
+};
+
+struct StartPacket {
+    std::uint8_t type;
+    std::uint8_t playerIndex;
+    std::uint8_t opponentInstantSoftDrop;
+    std::uint8_t reserved;
+    std::uint32_t seed;
+    float opponentDasDelay;
+    float opponentArrDelay;
+};
+
+// inputs[i] is the GameKey bitmask held during tick firstTick + i. The
+// checksum covers the match state after checksumTick, the newest tick the
+// sender has simulated with confirmed inputs from both sides.
+struct InputPacket {
+    std::uint8_t type;
+    std::uint8_t count;
+    std::uint16_t reserved;
+    std::uint32_t firstTick;
+    std::uint32_t ackTick;
+    std::uint32_t checksumTick;
+    std::uint32_t checksum;
+    std::uint8_t inputs[INPUT_REDUNDANCY];
+};
+
+static_assert(sizeof(HelloPacket) == 12, "HelloPacket must be 12 bytes");
+static_assert(sizeof(StartPacket) == 16, "StartPacket must be 16 bytes");
+static_assert(sizeof(InputPacket) == 36, "InputPacket must be 36 bytes");
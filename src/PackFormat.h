@@ -0,0 +1,33 @@
+/*
+ * Tetris Game - Asset pack file format
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstdint>
+
+// assets.pak layout (little-endian):
+//   PackHeader
+//   PackEntry[count], sorted by name
+//   file data, each blob starting on a PACK_ALIGN boundary
+const char PACK_MAGIC[4] = {'T', 'P', 'A', 'K'};
+const std::uint32_t PACK_VERSION = 1;
+const std::uint32_t PACK_ALIGN = 16;
+const int PACK_NAME_LEN = 48;
+
+struct PackHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint32_t reserved;
+};
+
+struct PackEntry {
+    char name[PACK_NAME_LEN];
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader must be 16 bytes");
+static_assert(sizeof(PackEntry) == 64, "PackEntry must be 64 bytes");
@@ -0,0 +1,168 @@
+/*
+ * Tetris Game - Background persistence worker implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Persist.h"
+#include "AllocStats.h"
+#include <condition_variable>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Persist {
+
+    static std::mutex mutex;
+    static std::condition_variable wake;
+    static std::condition_variable idle;
+    static std::map<std::string, std::string> pending;
+    static std::map<std::string, std::string> pendingAppends;
+    static bool running = false;
+    static bool busy = false;
+    static std::thread worker;
+
+/** Flush file contents to the device */
+    static bool syncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+/** Write contents to path.tmp, sync it, then rename it over path */
+    bool writeAtomic(const std::string& path, const std::string& contents) {
+        std::string tmp = path + ".tmp";
+        std::FILE* file = std::fopen(tmp.c_str(), "wb");
+        if (!file) return false;
+
+        bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+        ok = syncFile(file) && ok;
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+
+#ifdef _WIN32
+        return MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) return false;
+
+        std::size_t slash = path.find_last_of('/');
+        std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+        int dirFd = ::open(dir.c_str(), O_RDONLY);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            ::close(dirFd);
+        }
+        return true;
+#endif
+    }
+
+/** Append contents to path and sync it before returning */
+    bool appendSynced(const std::string& path, const std::string& contents) {
+        std::FILE* file = std::fopen(path.c_str(), "ab");
+        if (!file) return false;
+
+        bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+        ok = syncFile(file) && ok;
+        ok = (std::fclose(file) == 0) && ok;
+        return ok;
+    }
+
+/** Drain pending writes until stopped */
+    static void workerLoop() {
+        AllocStats::Scope scope(AllocStats::Subsystem::IO);
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [] { return !pending.empty() || !pendingAppends.empty() || !running; });
+            if (pending.empty() && pendingAppends.empty() && !running) break;
+
+            std::map<std::string, std::string> batch;
+            std::map<std::string, std::string> appends;
+            batch.swap(pending);
+            appends.swap(pendingAppends);
+            busy = true;
+            lock.unlock();
+
+            for (const auto& item : appends) {
+                if (!appendSynced(item.first, item.second)) {
+                    std::fprintf(stderr, "Persist: failed to append to %s\n", item.first.c_str());
+                }
+            }
+            for (const auto& item : batch) {
+                if (!writeAtomic(item.first, item.second)) {
+                    std::fprintf(stderr, "Persist: failed to write %s\n", item.first.c_str());
+                }
+            }
+
+            lock.lock();
+            busy = false;
+            idle.notify_all();
+        }
+    }
+
+/** Start the worker thread */
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) return;
+        running = true;
+        worker = std::thread(workerLoop);
+    }
+
+/** Write everything still queued and join the worker */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) return;
+            running = false;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+/** Queue a whole-file replacement; falls back to a direct write when stopped */
+    void writeFile(const std::string& path, const std::string& contents) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (running) {
+                pending[path] = contents;
+                wake.notify_one();
+                return;
+            }
+        }
+        writeAtomic(path, contents);
+    }
+
+/** Queue bytes to append; appends to one path keep their order */
+    void appendFile(const std::string& path, const std::string& contents) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (running) {
+                pendingAppends[path] += contents;
+                wake.notify_one();
+                return;
+            }
+        }
+        appendSynced(path, contents);
+    }
+
+/** Block until every queued write has reached the disk */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [] { return pending.empty() && pendingAppends.empty() && !busy; });
+    }
+}
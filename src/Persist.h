@@ -0,0 +1,27 @@
+/*
+ * Tetris Game - Background persistence worker
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <string>
+
+// Save files are handed to a worker thread and replaced atomically
+// (temp file + fsync + rename), so a crash never leaves a torn file and
+// the render loop never waits on the disk. Repeated writes to the same
+// path before the worker gets to them are coalesced into the newest one.
+// Appends are queued in order and applied before whole-file writes from
+// the same batch, so an index written after an append never gets ahead
+// of the log it describes.
+namespace Persist {
+    void start();
+    void stop();
+
+    void writeFile(const std::string& path, const std::string& contents);
+    void appendFile(const std::string& path, const std::string& contents);
+    void flush();
+
+    bool writeAtomic(const std::string& path, const std::string& contents);
+    bool appendSynced(const std::string& path, const std::string& contents);
+}
@@ -8,11 +8,50 @@
 #include "Game.h"
 #include <cstdlib>
 #include <algorithm>
+#include <new>
+
+// Every piece class fits one block; freed blocks are kept for reuse by
+// the thread that frees them and returned to the heap at thread exit.
+static const std::size_t PIECE_BLOCK = std::max({sizeof(IPiece), sizeof(OPiece), sizeof(TPiece), sizeof(SPiece),
+                                                 sizeof(ZPiece), sizeof(JPiece), sizeof(LPiece)});
+
+struct PieceFreeList {
+    void* head = nullptr;
+
+    ~PieceFreeList() {
+        while (head) {
+            void* next = *static_cast<void**>(head);
+            ::operator delete(head);
+            head = next;
+        }
+    }
+};
+
+static thread_local PieceFreeList freePieces;
+
+void* Piece::operator new(std::size_t size) {
+    if (size <= PIECE_BLOCK && freePieces.head) {
+        void* block = freePieces.head;
+        freePieces.head = *static_cast<void**>(block);
+        return block;
+    }
+    return ::operator new(std::max(size, PIECE_BLOCK));
+}
+
+void Piece::operator delete(void* block, std::size_t size) {
+    if (!block) return;
+    if (size > PIECE_BLOCK) {
+        ::operator delete(block);
+        return;
+    }
+    *static_cast<void**>(block) = freePieces.head;
+    freePieces.head = block;
+}
 
 /** Process shuffleBag */
 void shuffleBag() {
     for (int i = 6; i > 0; i--) {
-        int j = rand() % (i + 1);
+        int j = static_cast<int>(bagRng() % (i + 1));
 /** Process shuffleBag */
         std::swap(pieceBag[i], pieceBag[j]);
     }
@@ -25,8 +64,11 @@ Piece* createRandomPiece() {
         shuffleBag();
     }
 
-    int pieceType = pieceBag[bagIndex++];
+    return createPiece(pieceBag[bagIndex++]);
+}
 
+/** Create a piece by index (I O T S Z J L, matching getPieceIndex) */
+Piece* createPiece(int pieceType) {
     switch (pieceType) {
         case 0: return new IPiece();
         case 1: return new OPiece();
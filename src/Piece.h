@@ -7,12 +7,14 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "Config.h"
+#include "Rules.h"
+#include <cstddef>
 
-extern char board[H][W];
+extern thread_local char board[H][W];
 
 
 // Game state management
-extern int x;
+extern thread_local int x;
 
 
 
@@ -31,6 +33,11 @@ public:
 
     virtual ~Piece() {}
 
+    // Pieces come from a per-thread free list, so spawns during play do
+    // not reach the heap once a game has recycled a few.
+    static void* operator new(std::size_t size);
+    static void operator delete(void* block, std::size_t size);
+
     virtual void rotate(int currentX, int currentY) {
         char temp[4][4];
 
@@ -42,27 +49,7 @@ public:
 
         int kicks[] = {0, -1, 1, -2, 2};
         for (int kick : kicks) {
-            bool canPlace = true;
-            for (int i = 0; i < 4; i++) {
-                for (int j = 0; j < 4; j++) {
-                    if (temp[i][j] != ' ') {
-                        int tx = currentX + j + kick;
-                        int ty = currentY + i;
-
-                        if (tx < 1 || tx >= W - 1 || ty >= H - 1) {
-                            canPlace = false;
-                            break;
-                        }
-                        if (board[ty][tx] != ' ') {
-                            canPlace = false;
-                            break;
-                        }
-                    }
-                }
-                if (!canPlace) break;
-            }
-
-            if (canPlace) {
+            if (Rules::fits<StandardBoard>(board, temp, currentX + kick, currentY)) {
                 for (int i = 0; i < 4; i++) {
                     for (int j = 0; j < 4; j++) {
                         shape[i][j] = temp[i][j];
@@ -136,27 +123,7 @@ public:
 
         int kicks[] = {0, -1, 1, -2, 2};
         for (int kick : kicks) {
-            bool canPlace = true;
-            for (int i = 0; i < 4; i++) {
-                for (int j = 0; j < 4; j++) {
-                    if (temp[i][j] != ' ') {
-                        int tx = currentX + j + kick;
-                        int ty = currentY + i;
-
-                        if (tx < 1 || tx >= W - 1 || ty >= H - 1) {
-                            canPlace = false;
-                            break;
-                        }
-                        if (board[ty][tx] != ' ') {
-                            canPlace = false;
-                            break;
-                        }
-                    }
-                }
-                if (!canPlace) break;
-            }
-
-            if (canPlace) {
+            if (Rules::fits<StandardBoard>(board, temp, currentX + kick, currentY)) {
                 for (int i = 0; i < 4; i++) {
                     for (int j = 0; j < 4; j++) {
                         shape[i][j] = temp[i][j];
@@ -246,3 +213,4 @@ inline sf::Color getShadowColor(char c) {
 
 void shuffleBag();
 Piece* createRandomPiece();
+Piece* createPiece(int pieceType);
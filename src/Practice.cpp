@@ -0,0 +1,199 @@
+/*
+ * Tetris Game - Practice mode undo implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Practice.h"
+#include "Game.h"
+
+namespace Practice {
+
+    static const std::uint8_t FLAG_CAN_HOLD = 1;
+    static const std::uint8_t FLAG_BACK_TO_BACK = 2;
+    static const std::uint8_t NO_PIECE = 0xF;
+    static const std::uint8_t GARBAGE_CELL = 8;
+    static const char pieceChars[7] = {'I', 'O', 'T', 'S', 'Z', 'J', 'L'};
+
+    static PackedState ring[UNDO_LEVELS];
+    static int head = 0;
+    static int count = 0;
+    static bool rewinding = false;
+    static float rewindTimer = 0.f;
+
+/** Cell code: 0 empty, 1-7 piece types, 8 garbage */
+    static std::uint8_t packCell(char c) {
+        if (c == ' ') return 0;
+        int index = getPieceIndex(c);
+        return index >= 0 ? static_cast<std::uint8_t>(index + 1) : GARBAGE_CELL;
+    }
+
+    static char unpackCell(std::uint8_t code) {
+        if (code == 0) return ' ';
+        return code <= 7 ? pieceChars[code - 1] : '#';
+    }
+
+    static std::uint8_t pieceType(const Piece* piece) {
+        if (!piece) return NO_PIECE;
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                if (piece->shape[i][j] != ' ') {
+                    int index = getPieceIndex(piece->shape[i][j]);
+                    return index >= 0 ? static_cast<std::uint8_t>(index) : NO_PIECE;
+                }
+            }
+        }
+        return NO_PIECE;
+    }
+
+    static void setNibble(std::uint8_t* bytes, int index, std::uint8_t value) {
+        std::uint8_t& byte = bytes[index / 2];
+        byte = (index & 1) ? static_cast<std::uint8_t>((byte & 0x0F) | (value << 4))
+                           : static_cast<std::uint8_t>((byte & 0xF0) | value);
+    }
+
+    static std::uint8_t getNibble(const std::uint8_t* bytes, int index) {
+        return (index & 1) ? bytes[index / 2] >> 4 : bytes[index / 2] & 0x0F;
+    }
+
+    static int unpackType(const std::uint8_t* bytes, int index) {
+        std::uint8_t type = getNibble(bytes, index);
+        return type == NO_PIECE ? -1 : type;
+    }
+
+    void reset() {
+        head = 0;
+        count = 0;
+        rewinding = false;
+        rewindTimer = 0.f;
+    }
+
+/** Pack the state at the current piece's spawn into the next ring slot */
+    void capture() {
+        PackedState& packed = ring[head];
+        for (int i = 0; i < H; i++) {
+            for (int j = 0; j < W; j++) {
+                setNibble(packed.cells, i * W + j, packCell(board[i][j]));
+            }
+        }
+
+        setNibble(packed.pieces, 0, pieceType(currentPiece));
+        setNibble(packed.pieces, 1, pieceType(nextPiece));
+        for (int i = 0; i < 4; i++) setNibble(packed.pieces, 2 + i, pieceType(nextQueue[i]));
+        setNibble(packed.pieces, 6, pieceType(holdPiece));
+        const TPiece* heldT = dynamic_cast<const TPiece*>(holdPiece);
+        setNibble(packed.pieces, 7, heldT ? static_cast<std::uint8_t>(heldT->rotationState) : 0);
+        packed.holdShape = 0;
+        for (int i = 0; holdPiece && i < 16; i++) {
+            if (holdPiece->shape[i / 4][i % 4] != ' ') packed.holdShape |= 1u << i;
+        }
+        for (int i = 0; i < 7; i++) setNibble(packed.bag, i, static_cast<std::uint8_t>(pieceBag[i]));
+        setNibble(packed.bag, 7, 0);
+
+        packed.bagIndex = static_cast<std::int8_t>(bagIndex);
+        packed.flags = (canHold ? FLAG_CAN_HOLD : 0) | (backToBackActive ? FLAG_BACK_TO_BACK : 0);
+        packed.lines = static_cast<std::int16_t>(gLines);
+        packed.level = static_cast<std::int16_t>(gLevel);
+        packed.currentLevel = static_cast<std::int16_t>(currentLevel);
+        packed.comboCount = static_cast<std::int16_t>(comboCount);
+        packed.lastClearLines = static_cast<std::int16_t>(lastClearLines);
+        packed.tSpinCount = static_cast<std::int16_t>(tSpinCount);
+        packed.tetrisCount = static_cast<std::int16_t>(tetrisCount);
+        for (int i = 0; i < 7; i++) packed.pieceCount[i] = static_cast<std::uint16_t>(pieceCount[i]);
+        packed.score = gScore;
+        packed.totalPieces = totalPieces;
+        packed.playTime = playTime;
+        packed.gameDelay = gameDelay;
+        packed.bagRng = bagRng;
+
+        head = (head + 1) % UNDO_LEVELS;
+        if (count < UNDO_LEVELS) count++;
+    }
+
+/** Rebuild the live game from a packed spawn state */
+    static void restore(const PackedState& packed) {
+        GameSnapshot snap;
+        saveSnapshot(snap);
+
+        for (int i = 0; i < H; i++) {
+            for (int j = 0; j < W; j++) {
+                snap.board[i][j] = unpackCell(getNibble(packed.cells, i * W + j));
+            }
+        }
+        snap.current = makePieceState(unpackType(packed.pieces, 0));
+        snap.next = makePieceState(unpackType(packed.pieces, 1));
+        for (int i = 0; i < 4; i++) snap.queue[i] = makePieceState(unpackType(packed.pieces, 2 + i));
+        int holdType = unpackType(packed.pieces, 6);
+        snap.hold = makePieceState(holdType);
+        if (holdType >= 0) {
+            snap.hold.rotationState = static_cast<std::int8_t>(getNibble(packed.pieces, 7));
+            for (int i = 0; i < 16; i++) {
+                snap.hold.shape[i / 4][i % 4] = (packed.holdShape & (1u << i)) ? pieceChars[holdType] : ' ';
+            }
+        }
+        for (int i = 0; i < 7; i++) snap.pieceBag[i] = getNibble(packed.bag, i);
+
+        snap.bagIndex = packed.bagIndex;
+        snap.canHold = (packed.flags & FLAG_CAN_HOLD) != 0;
+        snap.backToBackActive = (packed.flags & FLAG_BACK_TO_BACK) != 0;
+        snap.gLines = packed.lines;
+        snap.gLevel = packed.level;
+        snap.currentLevel = packed.currentLevel;
+        snap.comboCount = packed.comboCount;
+        snap.lastClearLines = packed.lastClearLines;
+        snap.tSpinCount = packed.tSpinCount;
+        snap.tetrisCount = packed.tetrisCount;
+        for (int i = 0; i < 7; i++) snap.pieceCount[i] = packed.pieceCount[i];
+        snap.gScore = packed.score;
+        snap.totalPieces = packed.totalPieces;
+        snap.playTime = packed.playTime;
+        snap.gameDelay = packed.gameDelay;
+        snap.bagRng = packed.bagRng;
+
+        snap.x = 4;
+        snap.y = 0;
+        snap.isGameOver = false;
+        snap.lastMoveWasRotate = false;
+        snap.lockTimer = 0.f;
+        snap.lockMoves = 0;
+        snap.onGround = false;
+        snap.gravityTimer = 0.f;
+        snap.blockInput = false;
+        restoreSnapshot(snap);
+    }
+
+/** Step back one piece; after a top-out, return to the spawn that caused it */
+    bool undo() {
+        if (count == 0) return false;
+        if (!isGameOver) {
+            if (count == 1) return false;
+            head = (head + UNDO_LEVELS - 1) % UNDO_LEVELS;
+            count--;
+        }
+        restore(ring[(head + UNDO_LEVELS - 1) % UNDO_LEVELS]);
+        return true;
+    }
+
+    int depth() {
+        return count > 0 ? count - 1 : 0;
+    }
+
+    void setRewinding(bool held) {
+        rewinding = held;
+        rewindTimer = 0.f;
+        if (held) undo();
+    }
+
+/** Keep rewinding while the undo key is held */
+    void advance(float dt) {
+        if (!rewinding) return;
+        rewindTimer += dt;
+        while (rewindTimer >= REWIND_DELAY) {
+            rewindTimer -= REWIND_INTERVAL;
+            if (!undo()) {
+                rewinding = false;
+                break;
+            }
+        }
+    }
+}
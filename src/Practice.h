@@ -0,0 +1,46 @@
+/*
+ * Tetris Game - Practice mode undo
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+#include <cstdint>
+#include <random>
+
+// Practice mode keeps the state at every piece spawn in a fixed ring of
+// bit-packed snapshots (board at 4 bits per cell, piece types as nibbles,
+// the held piece's kept rotation as a 16-bit mask, counters narrowed), so
+// capturing never allocates and UNDO_LEVELS steps cost about
+// UNDO_LEVELS * sizeof(PackedState) bytes. Undo steps back one piece;
+// holding the key keeps rewinding at REWIND_INTERVAL.
+namespace Practice {
+    const int UNDO_LEVELS = 2048;
+    const float REWIND_DELAY = 0.25f;
+    const float REWIND_INTERVAL = 0.08f;
+
+    struct PackedState {
+        std::uint8_t cells[H * W / 2];
+        std::uint8_t pieces[4];
+        std::uint16_t holdShape;
+        std::uint8_t bag[4];
+        std::int8_t bagIndex;
+        std::uint8_t flags;
+        std::int16_t lines, level, currentLevel;
+        std::int16_t comboCount, lastClearLines;
+        std::int16_t tSpinCount, tetrisCount;
+        std::uint16_t pieceCount[7];
+        std::int32_t score, totalPieces;
+        float playTime, gameDelay;
+        std::minstd_rand bagRng;
+    };
+
+    void reset();
+    void capture();
+    bool undo();
+    int depth();
+
+    void setRewinding(bool held);
+    void advance(float dt);
+}
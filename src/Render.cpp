@@ -0,0 +1,368 @@
+/*
+ * Tetris Game - Render thread implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Render.h"
+#include "AllocStats.h"
+#include "FrameArena.h"
+#include "Input.h"
+#include "TileShader.h"
+#include "TripleBuffer.h"
+#include "UI.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace Render {
+
+    static TripleBuffer<Frame> frames;
+    static std::thread renderer;
+    static std::atomic<bool> running{false};
+    static std::atomic<bool> sleeping{false};
+    static std::mutex idleMutex;
+    static std::condition_variable wake;
+
+    // Frame draw times, written by the render thread and read after it is
+    // joined: a histogram of DRAW_BUCKET_US buckets, the last one open-ended.
+    static const int DRAW_BUCKET_US = 20;
+    static const int DRAW_BUCKETS = 1000;
+    static int drawHistogram[DRAW_BUCKETS];
+    static int drawFrames = 0;
+    static double drawTotalMs = 0.0;
+    static float drawMaxMs = 0.f;
+    static bool drawShaderTiles = false;
+
+    // Heap traffic over the current half-second window of the debug
+    // overlay, and the last complete window it shows.
+    struct OverlayStats {
+        AllocStats::Totals start;
+        double windowStart;
+        int frames;
+        AllocStats::Totals shown;
+        int shownFrames;
+        float frameMs;
+    };
+
+    // Where the active piece was in a published frame; two consecutive
+    // poses of the same piece are blended by the time since the newer one.
+    struct Pose {
+        double time;
+        int x, y;
+        int pieces;
+        std::int8_t type;
+        bool canHold;
+    };
+
+    static Pose poseOf(const Frame& frame) {
+        return {frame.time, frame.game.x, frame.game.y, frame.game.totalPieces,
+                frame.game.current.type, frame.game.canHold};
+    }
+
+/** Piece position to draw at time now: one step behind, moving toward current */
+    static sf::Vector2f interpolate(const Pose& previous, const Pose& current, double now) {
+        sf::Vector2f at(static_cast<float>(current.x), static_cast<float>(current.y));
+        bool samePiece = previous.pieces == current.pieces && previous.type == current.type &&
+                         previous.canHold == current.canHold;
+        // Hard drops, instant soft drops and kicks jump; only single steps glide.
+        bool step = std::abs(current.x - previous.x) <= 1 && std::abs(current.y - previous.y) <= 1;
+        double tick = current.time - previous.time;
+        if (!samePiece || !step || tick <= 0.0) return at;
+        float alpha = static_cast<float>(std::min(1.0, std::max(0.0, (now - current.time) / tick)));
+        at.x = previous.x + (current.x - previous.x) * alpha;
+        at.y = previous.y + (current.y - previous.y) * alpha;
+        return at;
+    }
+
+    static void drawPlayfield(sf::RenderTarget& window, const sf::Font& font, const SidebarUI& sidebarUI,
+                              const Frame& frame, sf::Vector2f piecePos) {
+        const float fieldOffsetX = STATS_W;
+
+        if (frame.versus) {
+            UI::drawOpponentBoard(window, font, frame.opponent, frame.desynced);
+        } else {
+            UI::drawPieceStats(window, font);
+        }
+
+        bool showGhost = currentPiece && ghostPieceEnabled && frame.state == GameState::PLAYING;
+        if (TileShader::active()) {
+            TileShader::drawField(window, {fieldOffsetX, 0.f}, board, showGhost ? currentPiece : nullptr,
+                                  x, showGhost ? getGhostY() : 0);
+        } else {
+            for (int i = 0; i < H; i++) {
+                for (int j = 0; j < W; j++) {
+                    UI::drawTile3D(window, fieldOffsetX + (float)(j * TILE_SIZE), (float)(i * TILE_SIZE),
+                                   TILE_SIZE, board[i][j]);
+                }
+            }
+        }
+
+        if (showGhost && !TileShader::active()) {
+            int ghostY = getGhostY();
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 4; j++) {
+                    if (currentPiece->shape[i][j] != ' ') {
+                        sf::RectangleShape ghost({TILE_SIZE - 1.f, TILE_SIZE - 1.f});
+                        ghost.setPosition({fieldOffsetX + (float)((x + j) * TILE_SIZE), (float)((ghostY + i) * TILE_SIZE)});
+                        sf::Color c = getColor(currentPiece->shape[i][j]);
+                        c.a = 60;
+                        ghost.setFillColor(c);
+                        ghost.setOutlineThickness(1.f);
+                        ghost.setOutlineColor(sf::Color(c.r, c.g, c.b, 120));
+                        window.draw(ghost);
+                    }
+                }
+            }
+        }
+
+        if (currentPiece) {
+            UI::drawSoftDropTrail(window, currentPiece, x, y, downHeld && canMove(0, 1));
+
+            if (TileShader::active()) {
+                TileShader::drawPiece(window, *currentPiece,
+                                      {fieldOffsetX + piecePos.x * TILE_SIZE, piecePos.y * TILE_SIZE}, TILE_SIZE);
+            } else {
+                for (int i = 0; i < 4; i++) {
+                    for (int j = 0; j < 4; j++) {
+                        if (currentPiece->shape[i][j] != ' ') {
+                            UI::drawTile3D(window, fieldOffsetX + (piecePos.x + j) * TILE_SIZE,
+                                           (piecePos.y + i) * TILE_SIZE,
+                                           TILE_SIZE, currentPiece->shape[i][j]);
+                        }
+                    }
+                }
+            }
+        }
+
+        UI::drawParticles(window);
+        UI::drawLineClearAnim(window);
+        UI::drawCombo(window, font);
+        UI::drawSidebar(window, sidebarUI, font, gScore, gLevel, gLines, nextPiece, nextQueue, holdPiece);
+
+        if (gameMode == GameMode::PRACTICE && !isGameOver) {
+            UI::drawPracticeBanner(window, font, frame.practiceDepth);
+        }
+
+        if (frame.watching) {
+            UI::drawSpectatorBanner(window, font, isGameOver);
+        }
+        else if (frame.replay) {
+            UI::drawReplayBanner(window, font, isGameOver);
+        }
+        else if (frame.versusWaiting) {
+            UI::drawVersusWaiting(window, font);
+        }
+        else if (isGameOver) {
+            UI::drawGameOverScreen(window, font, frame.versusResult, frame.rankedGames);
+        }
+
+        if (frame.state == GameState::PAUSED) {
+            UI::drawPauseScreen(window, font);
+        }
+    }
+
+    static void drawOverlay(sf::RenderTarget& window, const sf::Font& font, OverlayStats& stats, double now) {
+        AllocStats::Scope scope(AllocStats::Subsystem::DEBUG);
+        stats.frames++;
+        if (now - stats.windowStart >= 0.5) {
+            AllocStats::Totals totals = AllocStats::totals();
+            stats.shown = AllocStats::difference(totals, stats.start);
+            stats.shownFrames = stats.frames;
+            stats.frameMs = static_cast<float>((now - stats.windowStart) * 1000.0 / stats.frames);
+            stats.start = totals;
+            stats.windowStart = now;
+            stats.frames = 0;
+        }
+        UI::drawAllocOverlay(window, font, stats.shown, stats.shownFrames, stats.frameMs);
+    }
+
+/** Sleep until a new frame is published or stop() is called */
+    static void waitForFrame() {
+        std::unique_lock<std::mutex> lock(idleMutex);
+        sleeping.store(true);
+        wake.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_MS),
+                      [] { return frames.fresh() || !running.load(); });
+        sleeping.store(false);
+    }
+
+    static void recordDrawTime(float ms) {
+        int bucket = static_cast<int>(ms * 1000.f / DRAW_BUCKET_US);
+        drawHistogram[std::min(std::max(bucket, 0), DRAW_BUCKETS - 1)]++;
+        drawFrames++;
+        drawTotalMs += ms;
+        drawMaxMs = std::max(drawMaxMs, ms);
+    }
+
+    static void applyEffects(const Frame& frame) {
+        for (int i = 0; i < frame.spawnCount; i++) {
+            const ParticleSpawn& spawn = frame.spawns[i];
+            UI::addParticles(spawn.x, spawn.y, spawn.color, spawn.count);
+        }
+        if (frame.clearedCount > 0) {
+            int lines[4];
+            std::copy(frame.clearedLines, frame.clearedLines + 4, lines);
+            UI::startLineClearAnim(lines, frame.clearedCount);
+        }
+    }
+
+    static void drawScreen(sf::RenderTarget& target, const sf::Font& font, const SidebarUI& sidebarUI,
+                           const Frame& frame, sf::Vector2f piecePos) {
+        target.clear(sf::Color::Black);
+        if (frame.state == GameState::MENU) {
+            UI::drawMenu(target, font);
+        }
+        else if (frame.state == GameState::PLAYING || frame.state == GameState::PAUSED) {
+            drawPlayfield(target, font, sidebarUI, frame, piecePos);
+        }
+        else if (frame.state == GameState::SETTINGS) {
+            UI::drawSettingsScreen(target, font);
+        }
+        else if (frame.state == GameState::HOWTOPLAY) {
+            UI::drawHowToPlay(target, font);
+        }
+        UI::drawBrightnessOverlay(target);
+    }
+
+    static void renderLoop(sf::RenderWindow* window, const sf::Font* font) {
+        if (!window->setActive(true)) return;
+        AllocStats::Scope scope(AllocStats::Subsystem::RENDER);
+        drawShaderTiles = TileShader::load();
+        SidebarUI sidebarUI = UI::makeSidebarUI();
+        OverlayStats overlay = {AllocStats::totals(), Input::now(), 0, {}, 0, 0.f};
+        sf::Clock frameClock;
+        sf::Clock drawClock;
+        Pose previous = {}, current = {};
+        bool hasFrame = false;
+        int focused = -1;
+
+        while (running.load(std::memory_order_acquire)) {
+            bool fresh = frames.update();
+            const Frame& frame = frames.front();
+            // Static screens are drawn once per published frame; gameplay
+            // keeps drawing so effects and piece motion stay smooth.
+            if (!fresh && !(hasFrame && frame.live)) {
+                waitForFrame();
+                frameClock.restart();
+                continue;
+            }
+
+            if (fresh) {
+                restoreSnapshot(frame.game);
+                restoreSettingsSnapshot(frame.settings);
+                applyEffects(frame);
+                previous = hasFrame ? current : poseOf(frame);
+                current = poseOf(frame);
+                hasFrame = true;
+                window->setView(frame.view);
+                // In focus, present at the display's refresh rate.
+                if (focused != (frame.focused ? 1 : 0)) {
+                    focused = frame.focused ? 1 : 0;
+                    window->setFramerateLimit(frame.focused ? 0 : BACKGROUND_FPS);
+                    window->setVerticalSyncEnabled(frame.focused);
+                }
+            }
+
+            FrameArena::reset();
+            drawClock.restart();
+            float dt = frameClock.restart().asSeconds();
+            if (frame.live) {
+                UI::updateLineClearAnim(dt);
+                UI::updateParticles(dt);
+            }
+
+            drawScreen(*window, *font, sidebarUI, frame, interpolate(previous, current, Input::now()));
+            if (frame.debugOverlay) drawOverlay(*window, *font, overlay, Input::now());
+            recordDrawTime(drawClock.getElapsedTime().asSeconds() * 1000.f);
+            window->display();
+        }
+        TileShader::unload();
+        (void)window->setActive(false);
+    }
+
+/** Hand the window's context to a new render thread; the caller must release it first */
+    void start(sf::RenderWindow& window, const sf::Font& font) {
+        if (running.load()) return;
+        std::fill(drawHistogram, drawHistogram + DRAW_BUCKETS, 0);
+        drawFrames = 0;
+        drawTotalMs = 0.0;
+        drawMaxMs = 0.f;
+        running.store(true);
+        renderer = std::thread(renderLoop, &window, &font);
+    }
+
+/** Join the render thread; its context is released so the caller can take the window back */
+    void stop() {
+        if (!running.load()) return;
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            running.store(false);
+        }
+        wake.notify_all();
+        renderer.join();
+    }
+
+/** Draw-time summary since start(); only valid once stop() has joined the thread */
+    Timings timings() {
+        Timings t = {drawFrames, 0.f, 0.f, 0.f, drawMaxMs, drawShaderTiles};
+        if (drawFrames == 0) return t;
+        t.meanMs = static_cast<float>(drawTotalMs / drawFrames);
+        int seen = 0;
+        for (int i = 0; i < DRAW_BUCKETS; i++) {
+            seen += drawHistogram[i];
+            float upperMs = (i + 1) * DRAW_BUCKET_US / 1000.f;
+            if (t.p50Ms == 0.f && seen * 2 >= drawFrames) t.p50Ms = upperMs;
+            if (t.p99Ms == 0.f && seen * 100 >= drawFrames * 99) t.p99Ms = upperMs;
+        }
+        return t;
+    }
+
+/** The caller's game is already live, so the active piece is drawn where it is */
+    void drawOffscreen(sf::RenderTarget& target, const sf::Font& font, float dt) {
+        static const SidebarUI sidebarUI = UI::makeSidebarUI();
+        Frame& next = frames.back();
+        applyEffects(next);
+        next.spawnCount = 0;
+        next.clearedCount = 0;
+        UI::updateLineClearAnim(dt);
+        UI::updateParticles(dt);
+        target.setView(next.view);
+        drawScreen(target, font, sidebarUI, next, {static_cast<float>(x), static_cast<float>(y)});
+    }
+
+    Frame& frame() {
+        return frames.back();
+    }
+
+/** Publish frame(); effects stay queued in the next one if this slot was never drawn */
+    void publish(double time) {
+        frames.back().time = time;
+        bool drawn = frames.publish();
+        Frame& next = frames.back();
+        if (drawn) {
+            next.spawnCount = 0;
+            next.clearedCount = 0;
+        }
+        if (sleeping.load()) {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            wake.notify_one();
+        }
+    }
+
+    void queueParticles(float x, float y, sf::Color color, int count) {
+        Frame& next = frames.back();
+        if (next.spawnCount >= MAX_PARTICLE_SPAWNS) return;
+        next.spawns[next.spawnCount++] = {x, y, color, count};
+    }
+
+    void queueLineClear(const int* lines, int count) {
+        Frame& next = frames.back();
+        std::copy(lines, lines + 4, next.clearedLines);
+        next.clearedCount = count;
+    }
+}
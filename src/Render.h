@@ -0,0 +1,76 @@
+/*
+ * Tetris Game - Render thread
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Config.h"
+#include "Game.h"
+
+// The main thread handles window events, input and the simulation; a
+// render thread owns the window's GL context and does all the drawing.
+// Every simulation tick the main thread fills frame() with an immutable
+// copy of everything the screens show and publishes it through a
+// lock-free triple buffer. The render thread restores the newest frame
+// into its own thread_local game and settings, so the UI draw functions
+// run unchanged, and draws the active piece between its last two
+// published poses. Effects the simulation triggers are queued into the
+// frame being filled and carried over when the render thread skips one.
+namespace Render {
+    const int MAX_PARTICLE_SPAWNS = 128;
+
+    struct ParticleSpawn {
+        float x, y;
+        sf::Color color;
+        int count;
+    };
+
+    struct Frame {
+        double time;
+        GameState state;
+        bool live;
+        bool focused;
+        bool debugOverlay;
+        bool versus, versusWaiting, desynced;
+        bool watching;
+        bool replay;
+        int versusResult;
+        int rankedGames;
+        int practiceDepth;
+        GameSnapshot game;
+        GameSnapshot opponent;
+        SettingsSnapshot settings;
+        sf::View view;
+        ParticleSpawn spawns[MAX_PARTICLE_SPAWNS];
+        int spawnCount;
+        int clearedLines[4];
+        int clearedCount;
+    };
+
+    // CPU time the render thread spent per frame updating effects and
+    // issuing draw calls, from clear to just before display, so vsync
+    // waits are left out. Counted since the last start(), along with
+    // whether the tiles were drawn by the tile shader.
+    struct Timings {
+        int frames;
+        float meanMs, p50Ms, p99Ms, maxMs;
+        bool shaderTiles;
+    };
+
+    void start(sf::RenderWindow& window, const sf::Font& font);
+    void stop();
+    Timings timings();
+
+    // Offscreen drawing without a render thread, for the replay exporter:
+    // frame() is drawn into target on the calling thread from the caller's
+    // own game, taking its queued effects and advancing them by dt.
+    void drawOffscreen(sf::RenderTarget& target, const sf::Font& font, float dt);
+
+// Called from the simulation thread only
+    Frame& frame();
+    void publish(double time);
+    void queueParticles(float x, float y, sf::Color color, int count);
+    void queueLineClear(const int* lines, int count);
+}
@@ -0,0 +1,189 @@
+/*
+ * Tetris Game - Game recording and playback implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Replay.h"
+#include "Game.h"
+#include "Persist.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace Replay {
+
+    static const char* REPLAY_DIR = "replays";
+
+    static bool autoRecord = false;
+    static thread_local bool recording = false;
+    static thread_local Recording current;
+
+    void setAutoRecord(bool enabled) {
+        autoRecord = enabled;
+    }
+
+/** Start recording a new live game; practice undo and versus rollback cannot be replayed */
+    void gameStarted() {
+        recording = false;
+        if (autoRecord && gameMode == GameMode::MARATHON) begin();
+    }
+
+/** Hand the finished live game to the persistence worker */
+    void gameFinished() {
+        Recording done;
+        if (!autoRecord || !end(done)) return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(REPLAY_DIR, ec);
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s/%lld_%08x.rpl", REPLAY_DIR,
+                      static_cast<long long>(std::time(nullptr)), done.header.seed);
+        Persist::writeFile(name, serialize(done));
+    }
+
+/** Record the calling thread's game from here on; call right after resetGame */
+    void begin() {
+        ReplayHeader& header = current.header;
+        header = {};
+        std::memcpy(header.magic, REPLAY_MAGIC, 4);
+        header.version = REPLAY_VERSION;
+        header.seed = gameSeed;
+        header.difficulty = static_cast<std::uint8_t>(difficulty);
+        header.mode = static_cast<std::uint8_t>(gameMode);
+        header.instantSoftDrop = instantSoftDrop ? 1 : 0;
+        header.dasDelay = DAS_DELAY;
+        header.arrDelay = ARR_DELAY;
+        current.records.clear();
+        recording = true;
+    }
+
+/** Stop recording and move the recording, with its final checksum, into out */
+    bool end(Recording& out) {
+        if (!recording) return false;
+        recording = false;
+        GameSnapshot snap;
+        saveSnapshot(snap);
+        current.header.recordCount = static_cast<std::uint32_t>(current.records.size());
+        current.header.finalChecksum = snapshotChecksum(snap);
+        out = std::move(current);
+        current.records.clear();
+        return true;
+    }
+
+/** Consecutive ticks of the same length share one record */
+    void recordAdvance(float dt) {
+        if (!recording) return;
+        if (!current.records.empty()) {
+            ReplayRecord& last = current.records.back();
+            if (last.kind == REPLAY_ADVANCE && last.dt == dt && last.count < 0xFFFF) {
+                last.count++;
+                return;
+            }
+        }
+        current.records.push_back({REPLAY_ADVANCE, 0, 1, dt});
+    }
+
+    void recordKey(GameKey key, bool pressed) {
+        if (!recording) return;
+        current.records.push_back({pressed ? REPLAY_KEY_DOWN : REPLAY_KEY_UP,
+                                   static_cast<std::uint8_t>(key), 1, 0.f});
+    }
+
+    std::string serialize(const Recording& recording) {
+        ReplayHeader header = recording.header;
+        header.recordCount = static_cast<std::uint32_t>(recording.records.size());
+        std::size_t recordBytes = recording.records.size() * sizeof(ReplayRecord);
+        std::string bytes(sizeof(header) + recordBytes, '\0');
+        std::memcpy(&bytes[0], &header, sizeof(header));
+        if (recordBytes > 0) std::memcpy(&bytes[sizeof(header)], recording.records.data(), recordBytes);
+        return bytes;
+    }
+
+/** Read a replay file; false when it is missing, truncated or from another version */
+    bool load(const std::string& path, Recording& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (bytes.size() < sizeof(ReplayHeader)) return false;
+
+        std::memcpy(&out.header, bytes.data(), sizeof(ReplayHeader));
+        const ReplayHeader& header = out.header;
+        if (std::memcmp(header.magic, REPLAY_MAGIC, 4) != 0 || header.version != REPLAY_VERSION) return false;
+        if (header.difficulty >= DIFFICULTY_COUNT || header.mode >= static_cast<int>(GameMode::COUNT)) return false;
+        if (bytes.size() != sizeof(ReplayHeader) + static_cast<std::size_t>(header.recordCount) * sizeof(ReplayRecord)) {
+            return false;
+        }
+        out.records.resize(header.recordCount);
+        if (header.recordCount > 0) {
+            std::memcpy(out.records.data(), bytes.data() + sizeof(ReplayHeader), header.recordCount * sizeof(ReplayRecord));
+        }
+        return true;
+    }
+
+/** Every .rpl file directly in dir, in name order */
+    std::vector<std::string> list(const std::string& dir) {
+        std::vector<std::string> paths;
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->path().extension() == ".rpl") paths.push_back(it->path().string());
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+/** Take on the recording's handling and start its game on the calling thread */
+    void start(const Recording& recording, Cursor& cursor) {
+        const ReplayHeader& header = recording.header;
+        difficulty = static_cast<Difficulty>(header.difficulty);
+        gameMode = static_cast<GameMode>(header.mode);
+        instantSoftDrop = header.instantSoftDrop != 0;
+        DAS_DELAY = header.dasDelay;
+        ARR_DELAY = header.arrDelay;
+        resetGame(header.seed);
+        cursor = {0, 0, 0.0};
+    }
+
+/** Apply records until the recorded game time reaches until; false once all are played */
+    bool play(const Recording& recording, Cursor& cursor, double until) {
+        const std::vector<ReplayRecord>& records = recording.records;
+        while (cursor.record < records.size()) {
+            const ReplayRecord& record = records[cursor.record];
+            if (record.kind == REPLAY_ADVANCE) {
+                if (cursor.time >= until) return true;
+                advanceGame(record.dt);
+                cursor.time += record.dt;
+                if (++cursor.repeat < record.count) continue;
+                cursor.repeat = 0;
+            } else {
+                onGameKey(static_cast<GameKey>(record.key), record.kind == REPLAY_KEY_DOWN);
+            }
+            cursor.record++;
+        }
+        return false;
+    }
+
+/** Play the whole recording; true when the game ends where it did when recorded */
+    bool run(const Recording& recording) {
+        Cursor cursor;
+        start(recording, cursor);
+        play(recording, cursor, std::numeric_limits<double>::infinity());
+        GameSnapshot snap;
+        saveSnapshot(snap);
+        return snapshotChecksum(snap) == recording.header.finalChecksum;
+    }
+
+/** Number of advanceGame calls the recording makes */
+    long long ticks(const Recording& recording) {
+        long long total = 0;
+        for (const ReplayRecord& record : recording.records) {
+            if (record.kind == REPLAY_ADVANCE) total += record.count;
+        }
+        return total;
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * Tetris Game - Game recording and playback
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+#include "ReplayFormat.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// A recording is the calling thread's game as the advanceGame and onGameKey
+// calls that drove it (see ReplayFormat.h). With auto-record on (--record)
+// every marathon game is written to replays/ when it ends; tools record
+// their own games between begin() and end(). Playback restores the
+// recording's difficulty, mode and handling on the calling thread, resets
+// the game to its seed and feeds the calls back in order.
+namespace Replay {
+    struct Recording {
+        ReplayHeader header;
+        std::vector<ReplayRecord> records;
+    };
+
+    // Playback position: the next record, how many of its advance calls
+    // are done, and the recorded game time played so far.
+    struct Cursor {
+        std::size_t record;
+        int repeat;
+        double time;
+    };
+
+    void setAutoRecord(bool enabled);
+    void gameStarted();
+    void gameFinished();
+
+    void begin();
+    bool end(Recording& out);
+    void recordAdvance(float dt);
+    void recordKey(GameKey key, bool pressed);
+
+    std::string serialize(const Recording& recording);
+    bool load(const std::string& path, Recording& out);
+    std::vector<std::string> list(const std::string& dir);
+
+    void start(const Recording& recording, Cursor& cursor);
+    bool play(const Recording& recording, Cursor& cursor, double until);
+    bool run(const Recording& recording);
+    long long ticks(const Recording& recording);
+}
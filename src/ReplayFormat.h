@@ -0,0 +1,49 @@
+/*
+ * Tetris Game - Replay file format
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstdint>
+
+// *.rpl layout (little-endian), one file per game:
+//   ReplayHeader
+//   ReplayRecord[recordCount]
+// A record is one advanceGame(dt) call, repeated count times, or one
+// onGameKey transition, in the order the game made them. The simulation
+// only changes through those two calls, so replaying the records on a
+// game reset with the header's seed and handling reproduces it exactly;
+// the final checksum tells when a rules change has made a replay stale.
+const char REPLAY_MAGIC[4] = {'T', 'R', 'P', 'L'};
+const std::uint32_t REPLAY_VERSION = 1;
+
+struct ReplayHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t recordCount;
+    std::uint32_t seed;
+    std::uint8_t difficulty;
+    std::uint8_t mode;
+    std::uint8_t instantSoftDrop;
+    std::uint8_t reserved;
+    float dasDelay;
+    float arrDelay;
+    std::uint32_t finalChecksum;
+};
+
+enum ReplayRecordKind : std::uint8_t {
+    REPLAY_ADVANCE = 0,
+    REPLAY_KEY_DOWN = 1,
+    REPLAY_KEY_UP = 2,
+};
+
+struct ReplayRecord {
+    std::uint8_t kind;
+    std::uint8_t key;
+    std::uint16_t count;
+    float dt;
+};
+
+static_assert(sizeof(ReplayHeader) == 32, "ReplayHeader must be 32 bytes");
+static_assert(sizeof(ReplayRecord) == 8, "ReplayRecord must be 8 bytes");
@@ -0,0 +1,158 @@
+/*
+ * Tetris Game - Playfield rules kernels
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Board.h"
+#include <algorithm>
+#include <type_traits>
+
+// The playfield the game draws, snapshots and sends is a char grid: a
+// Board's interior with a wall column on each side and a floor row under
+// it, ' ' for an empty cell. These are the piece rules on that grid
+// (fit, drop, shift, line clears, garbage), templates over the Board
+// geometry like the bitboard kernels, so every bound is a constant and
+// the guideline and wide fields get the same rules. Walls and floor are
+// cells, so the drop and shift scans stop on them without bounds checks.
+// The live game runs them on board as StandardBoard; sounds, particles
+// and the position hash stay with the callers in Game.cpp.
+template <typename Board>
+using Cells = char[Board::ROWS + 1][Board::COLS + 2];
+
+static_assert(std::is_same<Cells<StandardBoard>, char[H][W]>::value, "the live field is a walled StandardBoard");
+
+namespace Rules {
+
+/** Empty interior inside the walls and floor */
+    template <typename Board>
+    void init(Cells<Board>& cells) {
+        const int rows = Board::ROWS + 1, cols = Board::COLS + 2;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                cells[i][j] = (i == rows - 1 || j == 0 || j == cols - 1) ? '#' : ' ';
+            }
+        }
+    }
+
+/** Whether a shape fits with its box's top-left at (x, y) */
+    template <typename Board>
+    bool fits(const Cells<Board>& cells, const char (&shape)[4][4], int x, int y) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                if (shape[i][j] == ' ') continue;
+                int tx = x + j, ty = y + i;
+                if (tx < 1 || tx > Board::COLS || ty >= Board::ROWS) return false;
+                if (cells[ty][tx] != ' ') return false;
+            }
+        }
+        return true;
+    }
+
+/** How far a shape at (x, y) falls before it lands */
+    template <typename Board>
+    int dropDistance(const Cells<Board>& cells, const char (&shape)[4][4], int x, int y) {
+        int drop = Board::ROWS + 1;
+        for (int j = 0; j < 4; j++) {
+            int bottom = -1;
+            for (int i = 3; i >= 0; i--) {
+                if (shape[i][j] != ' ') {
+                    bottom = i;
+                    break;
+                }
+            }
+            if (bottom < 0) continue;
+
+            int dist = 0;
+            while (cells[y + bottom + dist + 1][x + j] == ' ') dist++;
+            drop = std::min(drop, dist);
+        }
+        return drop == Board::ROWS + 1 ? 0 : drop;
+    }
+
+/** Free cells between a shape at (x, y) and the nearest obstacle in dir (-1 or 1) */
+    template <typename Board>
+    int shiftDistance(const Cells<Board>& cells, const char (&shape)[4][4], int x, int y, int dir) {
+        int shift = Board::COLS + 2;
+        for (int i = 0; i < 4; i++) {
+            int edge = -1;
+            for (int j = 0; j < 4; j++) {
+                int col = (dir < 0) ? j : 3 - j;
+                if (shape[i][col] != ' ') {
+                    edge = col;
+                    break;
+                }
+            }
+            if (edge < 0) continue;
+
+            int dist = 0;
+            while (cells[y + i][x + edge + (dist + 1) * dir] == ' ') dist++;
+            shift = std::min(shift, dist);
+        }
+        return shift == Board::COLS + 2 ? 0 : shift;
+    }
+
+/** Height of the tallest column above the floor */
+    template <typename Board>
+    int stackHeight(const Cells<Board>& cells) {
+        for (int i = 0; i < Board::ROWS; i++) {
+            for (int j = 1; j <= Board::COLS; j++) {
+                if (cells[i][j] != ' ') return Board::ROWS - i;
+            }
+        }
+        return 0;
+    }
+
+/** Whether every interior cell of a row is filled */
+    template <typename Board>
+    bool rowFull(const Cells<Board>& cells, int row) {
+        for (int j = 1; j <= Board::COLS; j++) {
+            if (cells[row][j] == ' ') return false;
+        }
+        return true;
+    }
+
+/** Drop a row and move the ones above it down; row 0 stays and row 1 empties */
+    template <typename Board>
+    void removeRow(Cells<Board>& cells, int row) {
+        for (int k = row; k > 0; k--) {
+            for (int j = 1; j <= Board::COLS; j++) {
+                cells[k][j] = (k != 1) ? cells[k - 1][j] : ' ';
+            }
+        }
+    }
+
+/** Whether rows 1 down to the floor are empty; row 0 is spawn space */
+    template <typename Board>
+    bool perfectClear(const Cells<Board>& cells) {
+        for (int i = 1; i < Board::ROWS; i++) {
+            for (int j = 1; j <= Board::COLS; j++) {
+                if (cells[i][j] != ' ') return false;
+            }
+        }
+        return true;
+    }
+
+/** Push 1..ROWS rows with a hole at column hole up from the floor; true if a filled cell went out the top */
+    template <typename Board>
+    bool pushGarbage(Cells<Board>& cells, int count, int hole) {
+        bool toppedOut = false;
+        for (int i = 0; i < count; i++) {
+            for (int j = 1; j <= Board::COLS; j++) {
+                if (cells[i][j] != ' ') toppedOut = true;
+            }
+        }
+        for (int i = 0; i < Board::ROWS - count; i++) {
+            for (int j = 1; j <= Board::COLS; j++) {
+                cells[i][j] = cells[i + count][j];
+            }
+        }
+        for (int i = Board::ROWS - count; i < Board::ROWS; i++) {
+            for (int j = 1; j <= Board::COLS; j++) {
+                cells[i][j] = (j == hole) ? ' ' : '#';
+            }
+        }
+        return toppedOut;
+    }
+}
@@ -0,0 +1,398 @@
+/*
+ * Tetris Game - Live spectator streaming implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Spectate.h"
+#include "AllocStats.h"
+#include "SpectateProtocol.h"
+#include "Game.h"
+#include "Net.h"
+#include "SpscQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Spectate {
+
+    typedef std::shared_ptr<const std::string> Message;
+
+    struct Viewer {
+        Net::Socket socket;
+        std::deque<Message> queue;
+        std::size_t offset;
+        std::size_t backlog;
+        bool stale;
+    };
+
+    static SpscQueue<View, 64> views;
+    static std::atomic<bool> serving{false};
+    static std::atomic<int> connectedViewers{0};
+    static std::thread broadcaster;
+    static Net::Socket listener = Net::INVALID_SOCKET_HANDLE;
+
+    static Net::Socket viewerSocket = Net::INVALID_SOCKET_HANDLE;
+    static std::string inbox;
+    static View watched;
+    static bool haveWatched = false;
+
+/** Append raw bytes of a value to a message under construction */
+    template <typename T>
+    static void put(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static void putPose(std::string& out, const View& view) {
+        put(out, view.pieceType);
+        put(out, view.x);
+        put(out, view.y);
+        out.append(&view.shape[0][0], 16);
+    }
+
+    static Message finish(std::string& out, std::uint8_t type, std::uint8_t flags, std::uint32_t tick) {
+        SpectateHeader header = {};
+        header.size = static_cast<std::uint16_t>(out.size() - sizeof(SpectateHeader));
+        header.type = type;
+        header.flags = flags;
+        header.tick = tick;
+        std::memcpy(&out[0], &header, sizeof(header));
+        return std::make_shared<const std::string>(std::move(out));
+    }
+
+    static Message makeKeyframe(const View& view, std::uint32_t tick) {
+        std::string out(sizeof(SpectateHeader), '\0');
+        out.append(&view.board[0][0], H * W);
+        putPose(out, view);
+        out.append(reinterpret_cast<const char*>(view.queue), SPECTATE_QUEUE_LEN);
+        put(out, view.hold);
+        put(out, view.score);
+        put(out, view.lines);
+        put(out, view.level);
+        put(out, view.gameOver);
+        return finish(out, SPECTATE_KEYFRAME, 0, tick);
+    }
+
+/** Smallest shift s with prev[s..] == next[..n-s]; the queue only ever advances */
+    static int queueShift(const View& prev, const View& next) {
+        for (int s = 0; s < SPECTATE_QUEUE_LEN; s++) {
+            if (std::memcmp(prev.queue + s, next.queue, SPECTATE_QUEUE_LEN - s) == 0) return s;
+        }
+        return SPECTATE_QUEUE_LEN;
+    }
+
+/** Encode what changed between two views; null when nothing did */
+    static Message makeDelta(const View& prev, const View& next, std::uint32_t tick) {
+        std::string out(sizeof(SpectateHeader), '\0');
+
+        std::uint32_t rowMask = 0;
+        for (int i = 0; i < H; i++) {
+            if (std::memcmp(prev.board[i], next.board[i], W) != 0) rowMask |= 1u << i;
+        }
+        put(out, rowMask);
+        for (int i = 0; i < H; i++) {
+            if (rowMask & (1u << i)) out.append(next.board[i], W);
+        }
+
+        std::uint8_t flags = 0;
+        if (prev.pieceType != next.pieceType || prev.x != next.x || prev.y != next.y ||
+            std::memcmp(prev.shape, next.shape, sizeof(next.shape)) != 0) {
+            flags |= DELTA_POSE;
+            putPose(out, next);
+        }
+        int shift = queueShift(prev, next);
+        if (shift > 0) {
+            flags |= DELTA_QUEUE;
+            put(out, static_cast<std::uint8_t>(shift));
+            out.append(reinterpret_cast<const char*>(next.queue + SPECTATE_QUEUE_LEN - shift), shift);
+        }
+        if (prev.hold != next.hold) {
+            flags |= DELTA_HOLD;
+            put(out, next.hold);
+        }
+        if (prev.score != next.score || prev.lines != next.lines || prev.level != next.level) {
+            flags |= DELTA_SCORE;
+            put(out, next.score);
+            put(out, next.lines);
+            put(out, next.level);
+        }
+        if (prev.gameOver != next.gameOver) {
+            flags |= DELTA_STATE;
+            put(out, next.gameOver);
+        }
+
+        if (rowMask == 0 && flags == 0) return nullptr;
+        return finish(out, SPECTATE_DELTA, flags, tick);
+    }
+
+/** Queue a shared message; a viewer that falls too far behind is marked for resync */
+    static void enqueue(Viewer& viewer, const Message& message) {
+        if (viewer.stale) return;
+        if (viewer.backlog + message->size() > MAX_BACKLOG) {
+            while (viewer.queue.size() > (viewer.offset > 0 ? 1u : 0u)) {
+                viewer.backlog -= viewer.queue.back()->size();
+                viewer.queue.pop_back();
+            }
+            viewer.stale = true;
+            return;
+        }
+        viewer.queue.push_back(message);
+        viewer.backlog += message->size();
+    }
+
+/** Write as much of the queue as the socket takes; false once the viewer is gone */
+    static bool flush(Viewer& viewer) {
+        while (!viewer.queue.empty()) {
+            const std::string& head = *viewer.queue.front();
+            int sent = Net::sendStream(viewer.socket, head.data() + viewer.offset, head.size() - viewer.offset);
+            if (sent < 0) return false;
+            if (sent == 0) return true;
+
+            viewer.offset += sent;
+            viewer.backlog -= sent;
+            if (viewer.offset == head.size()) {
+                viewer.queue.pop_front();
+                viewer.offset = 0;
+            }
+        }
+        return true;
+    }
+
+/** Accept viewers, diff incoming views and fan messages out until stopped */
+    static void broadcastLoop() {
+        AllocStats::Scope scope(AllocStats::Subsystem::NET);
+        std::vector<Viewer> viewers;
+        View last = {};
+        bool haveLast = false;
+        std::uint32_t tick = 0;
+
+        while (serving.load(std::memory_order_relaxed)) {
+            bool busy = false;
+
+            Net::Socket accepted;
+            while ((accepted = Net::acceptStream(listener)) != Net::INVALID_SOCKET_HANDLE) {
+                viewers.push_back({accepted, {}, 0, 0, true});
+            }
+
+            View view;
+            while (views.pop(view)) {
+                busy = true;
+                Message message = haveLast ? makeDelta(last, view, tick) : makeKeyframe(view, tick);
+                last = view;
+                haveLast = true;
+                tick++;
+                if (!message) continue;
+                for (Viewer& viewer : viewers) enqueue(viewer, message);
+            }
+
+            Message keyframe;
+            for (std::size_t i = 0; i < viewers.size();) {
+                Viewer& viewer = viewers[i];
+                if (viewer.stale && haveLast && viewer.offset == 0 && viewer.queue.empty()) {
+                    if (!keyframe) keyframe = makeKeyframe(last, tick - 1);
+                    viewer.stale = false;
+                    enqueue(viewer, keyframe);
+                }
+                if (!flush(viewer)) {
+                    Net::closeSocket(viewer.socket);
+                    viewers[i] = viewers.back();
+                    viewers.pop_back();
+                    continue;
+                }
+                if (!viewer.queue.empty()) busy = true;
+                i++;
+            }
+            connectedViewers.store(static_cast<int>(viewers.size()), std::memory_order_relaxed);
+
+            if (!busy) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        for (Viewer& viewer : viewers) Net::closeSocket(viewer.socket);
+        connectedViewers.store(0, std::memory_order_relaxed);
+    }
+
+/** Listen for viewers and start the broadcaster thread */
+    bool startServer(const std::string& endpoint) {
+        if (serving.load()) return false;
+        listener = Net::listenStream(endpoint);
+        if (listener == Net::INVALID_SOCKET_HANDLE) {
+            std::fprintf(stderr, "Spectate: cannot listen on %s\n", endpoint.c_str());
+            return false;
+        }
+        serving.store(true);
+        broadcaster = std::thread(broadcastLoop);
+        std::printf("Spectate: broadcasting on %s\n", endpoint.c_str());
+        return true;
+    }
+
+    void stopServer() {
+        if (!serving.exchange(false)) return;
+        broadcaster.join();
+        Net::closeSocket(listener);
+        listener = Net::INVALID_SOCKET_HANDLE;
+    }
+
+/** Capture the live field for the broadcaster; drops the frame when it is behind */
+    void publish() {
+        if (!serving.load(std::memory_order_relaxed)) return;
+
+        GameSnapshot snap;
+        saveSnapshot(snap);
+
+        View view;
+        std::memcpy(view.board, snap.board, sizeof(view.board));
+        view.pieceType = snap.current.type;
+        view.x = static_cast<std::int8_t>(snap.x);
+        view.y = static_cast<std::int8_t>(snap.y);
+        std::memcpy(view.shape, snap.current.shape, sizeof(view.shape));
+        view.queue[0] = snap.next.type;
+        for (int i = 0; i < 4; i++) view.queue[i + 1] = snap.queue[i].type;
+        view.hold = snap.hold.type;
+        view.score = snap.gScore;
+        view.lines = snap.gLines;
+        view.level = snap.gLevel;
+        view.gameOver = snap.isGameOver ? 1 : 0;
+        views.push(view);
+    }
+
+    int viewerCount() {
+        return connectedViewers.load(std::memory_order_relaxed);
+    }
+
+/** Connect to a broadcaster as a read-only viewer */
+    bool watch(const std::string& endpoint) {
+        viewerSocket = Net::connectStream(endpoint, SPECTATE_PORT);
+        if (viewerSocket == Net::INVALID_SOCKET_HANDLE) {
+            std::fprintf(stderr, "Spectate: cannot connect to %s\n", endpoint.c_str());
+            return false;
+        }
+        inbox.clear();
+        haveWatched = false;
+        return true;
+    }
+
+    bool watching() {
+        return viewerSocket != Net::INVALID_SOCKET_HANDLE;
+    }
+
+    void stopWatching() {
+        Net::closeSocket(viewerSocket);
+        viewerSocket = Net::INVALID_SOCKET_HANDLE;
+    }
+
+/** Sequential reader over one message payload */
+    struct Reader {
+        const char* at;
+        const char* end;
+
+        template <typename T>
+        T get() {
+            T value = {};
+            if (end - at >= static_cast<std::ptrdiff_t>(sizeof(T))) std::memcpy(&value, at, sizeof(T));
+            at += sizeof(T);
+            return value;
+        }
+        void bytes(void* out, std::size_t size) {
+            if (end - at >= static_cast<std::ptrdiff_t>(size)) std::memcpy(out, at, size);
+            at += size;
+        }
+    };
+
+    static void readPose(Reader& in, View& view) {
+        view.pieceType = in.get<std::int8_t>();
+        view.x = in.get<std::int8_t>();
+        view.y = in.get<std::int8_t>();
+        in.bytes(view.shape, sizeof(view.shape));
+    }
+
+    static void applyMessage(const SpectateHeader& header, Reader in) {
+        if (header.type == SPECTATE_KEYFRAME) {
+            in.bytes(watched.board, sizeof(watched.board));
+            readPose(in, watched);
+            in.bytes(watched.queue, SPECTATE_QUEUE_LEN);
+            watched.hold = in.get<std::int8_t>();
+            watched.score = in.get<std::int32_t>();
+            watched.lines = in.get<std::int32_t>();
+            watched.level = in.get<std::int32_t>();
+            watched.gameOver = in.get<std::uint8_t>();
+            haveWatched = true;
+            return;
+        }
+        if (header.type != SPECTATE_DELTA || !haveWatched) return;
+
+        std::uint32_t rowMask = in.get<std::uint32_t>();
+        for (int i = 0; i < H; i++) {
+            if (rowMask & (1u << i)) in.bytes(watched.board[i], W);
+        }
+        if (header.flags & DELTA_POSE) readPose(in, watched);
+        if (header.flags & DELTA_QUEUE) {
+            int shift = std::min<int>(in.get<std::uint8_t>(), SPECTATE_QUEUE_LEN);
+            std::memmove(watched.queue, watched.queue + shift, SPECTATE_QUEUE_LEN - shift);
+            in.bytes(watched.queue + SPECTATE_QUEUE_LEN - shift, shift);
+        }
+        if (header.flags & DELTA_HOLD) watched.hold = in.get<std::int8_t>();
+        if (header.flags & DELTA_SCORE) {
+            watched.score = in.get<std::int32_t>();
+            watched.lines = in.get<std::int32_t>();
+            watched.level = in.get<std::int32_t>();
+        }
+        if (header.flags & DELTA_STATE) watched.gameOver = in.get<std::uint8_t>();
+    }
+
+/** Make the watched view the live game state so the normal renderer draws it */
+    static void showWatched() {
+        GameSnapshot snap;
+        saveSnapshot(snap);
+        std::memcpy(snap.board, watched.board, sizeof(snap.board));
+        snap.current = makePieceState(watched.pieceType);
+        std::memcpy(snap.current.shape, watched.shape, sizeof(watched.shape));
+        snap.x = watched.x;
+        snap.y = watched.y;
+        snap.next = makePieceState(watched.queue[0]);
+        for (int i = 0; i < 4; i++) snap.queue[i] = makePieceState(watched.queue[i + 1]);
+        snap.hold = makePieceState(watched.hold);
+        snap.gScore = watched.score;
+        snap.gLines = watched.lines;
+        snap.gLevel = watched.level;
+        snap.isGameOver = watched.gameOver != 0;
+        restoreSnapshot(snap);
+    }
+
+/** Read and apply everything the broadcaster sent; false once the stream closes */
+    bool pollViewer() {
+        if (!watching()) return false;
+
+        char buffer[4096];
+        int received;
+        while ((received = Net::receiveStream(viewerSocket, buffer, sizeof(buffer))) > 0) {
+            inbox.append(buffer, received);
+        }
+
+        std::size_t at = 0;
+        bool changed = false;
+        while (inbox.size() - at >= sizeof(SpectateHeader)) {
+            SpectateHeader header;
+            std::memcpy(&header, inbox.data() + at, sizeof(header));
+            if (inbox.size() - at - sizeof(header) < header.size) break;
+
+            const char* payload = inbox.data() + at + sizeof(header);
+            applyMessage(header, Reader{payload, payload + header.size});
+            at += sizeof(header) + header.size;
+            changed = true;
+        }
+        inbox.erase(0, at);
+
+        if (changed && haveWatched) showWatched();
+        if (received < 0) {
+            stopWatching();
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,42 @@
+/*
+ * Tetris Game - Live spectator streaming
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+#include <cstdint>
+#include <string>
+
+// The game thread captures a small view of the field every frame and hands
+// it to a broadcaster thread through a lock-free queue; if that queue is
+// full the frame is skipped, so viewers never slow the game down. The
+// broadcaster turns consecutive views into a keyframe or a delta (see
+// SpectateProtocol.h), serializes each message once and queues the same
+// buffer on every viewer. A viewer whose backlog passes MAX_BACKLOG loses
+// its queued deltas and is resynced from a fresh keyframe.
+namespace Spectate {
+    const std::size_t MAX_BACKLOG = 64 * 1024;
+
+    struct View {
+        char board[H][W];
+        std::int8_t pieceType;
+        std::int8_t x, y;
+        char shape[4][4];
+        std::int8_t queue[5];
+        std::int8_t hold;
+        std::int32_t score, lines, level;
+        std::uint8_t gameOver;
+    };
+
+    bool startServer(const std::string& endpoint);
+    void stopServer();
+    void publish();
+    int viewerCount();
+
+    bool watch(const std::string& endpoint);
+    bool pollViewer();
+    bool watching();
+    void stopWatching();
+}
@@ -0,0 +1,45 @@
+/*
+ * Tetris Game - Spectator stream format
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstdint>
+
+// One-way byte stream from the broadcaster to each viewer (little-endian).
+// Every message is a SpectateHeader followed by size payload bytes.
+//   KEYFRAME: board (H*W bytes), pose, queue (5 types), hold, score, state
+//   DELTA:    u32 changed-row mask, W bytes per changed row (top first),
+//             then one section per set flag, in flag order
+// Sections:
+//   pose   i8 type, i8 x, i8 y, 16 shape bytes
+//   queue  u8 shift, then shift piece types appended at the tail
+//   hold   i8 type
+//   score  i32 score, i32 lines, i32 level
+//   state  u8 game over
+// Piece types are getPieceIndex values, -1 for none.
+const std::uint16_t SPECTATE_PORT = 7780;
+const int SPECTATE_QUEUE_LEN = 5;
+
+enum SpectateMessage : std::uint8_t {
+    SPECTATE_KEYFRAME = 1,
+    SPECTATE_DELTA = 2,
+};
+
+enum SpectateFlags : std::uint8_t {
+    DELTA_POSE = 1,
+    DELTA_QUEUE = 2,
+    DELTA_HOLD = 4,
+    DELTA_SCORE = 8,
+    DELTA_STATE = 16,
+};
+
+struct SpectateHeader {
+    std::uint16_t size;
+    std::uint8_t type;
+    std::uint8_t flags;
+    std::uint32_t tick;
+};
+
+static_assert(sizeof(SpectateHeader) == 8, "SpectateHeader must be 8 bytes");
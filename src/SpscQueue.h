@@ -0,0 +1,41 @@
+/*
+ * Tetris Game - Lock-free single-producer/single-consumer ring buffer
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity queue shared by exactly one producer thread and one
+// consumer thread. Capacity must be a power of two; one slot stays empty.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /** Push an item, returns false when the queue is full */
+    bool push(const T& item) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t next = (tail + 1) & (Capacity - 1);
+        if (next == head_.load(std::memory_order_acquire)) return false;
+        items_[tail] = item;
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /** Pop the oldest item, returns false when the queue is empty */
+    bool pop(T& item) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        item = items_[head];
+        head_.store((head + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    T items_[Capacity];
+};
@@ -0,0 +1,156 @@
+/*
+ * Tetris Game - Per-piece session telemetry implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Telemetry.h"
+#include "TelemetryFormat.h"
+#include "Game.h"
+#include "Persist.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Telemetry {
+
+    static const char* TELEMETRY_DIR = "telemetry";
+
+    static bool active = false;
+    static std::int64_t startedAt = 0;
+    static std::vector<float> lockTimes;
+    static std::vector<std::uint8_t> pieces;
+    static std::vector<std::int8_t> xs;
+    static std::vector<std::int8_t> ys;
+    static std::vector<std::uint8_t> lines;
+    static std::vector<std::uint8_t> tSpins;
+    static std::vector<std::uint16_t> combos;
+    static std::vector<std::uint8_t> backToBacks;
+    static std::vector<std::uint8_t> stackHeights;
+    static std::vector<std::uint8_t> helds;
+
+    struct ColumnData {
+        const char* name;
+        const void* data;
+        std::uint32_t elementSize;
+    };
+
+/** Drop all collected rows */
+    static void clearColumns() {
+        lockTimes.clear();
+        pieces.clear();
+        xs.clear();
+        ys.clear();
+        lines.clear();
+        tSpins.clear();
+        combos.clear();
+        backToBacks.clear();
+        stackHeights.clear();
+        helds.clear();
+    }
+
+/** Serialize the current session; header, column table, then packed columns */
+    static std::string serialize() {
+        const ColumnData columns[] = {
+            {"lockTime", lockTimes.data(), sizeof(float)},
+            {"piece", pieces.data(), 1},
+            {"x", xs.data(), 1},
+            {"y", ys.data(), 1},
+            {"lines", lines.data(), 1},
+            {"tspin", tSpins.data(), 1},
+            {"combo", combos.data(), sizeof(std::uint16_t)},
+            {"b2b", backToBacks.data(), 1},
+            {"stackHeight", stackHeights.data(), 1},
+            {"held", helds.data(), 1},
+        };
+        const std::uint32_t columnCount = sizeof(columns) / sizeof(columns[0]);
+        const std::uint32_t rows = static_cast<std::uint32_t>(lockTimes.size());
+
+        TelemetryHeader header = {};
+        std::memcpy(header.magic, TELEMETRY_MAGIC, 4);
+        header.version = TELEMETRY_VERSION;
+        header.rowCount = rows;
+        header.columnCount = columnCount;
+        std::strncpy(header.player, playerName.c_str(), TELEMETRY_PLAYER_LEN - 1);
+        header.startedAt = startedAt;
+        header.seed = gameSeed;
+        header.difficulty = static_cast<std::uint8_t>(difficulty);
+        header.mode = static_cast<std::uint8_t>(gameMode);
+
+        std::vector<TelemetryColumn> table(columnCount);
+        std::uint64_t offset = sizeof(TelemetryHeader) + columnCount * sizeof(TelemetryColumn);
+        for (std::uint32_t i = 0; i < columnCount; i++) {
+            offset = (offset + TELEMETRY_ALIGN - 1) / TELEMETRY_ALIGN * TELEMETRY_ALIGN;
+            table[i] = {};
+            std::strncpy(table[i].name, columns[i].name, TELEMETRY_NAME_LEN - 1);
+            table[i].elementSize = columns[i].elementSize;
+            table[i].offset = offset;
+            offset += static_cast<std::uint64_t>(rows) * columns[i].elementSize;
+        }
+
+        std::string bytes(static_cast<std::size_t>(offset), '\0');
+        std::memcpy(&bytes[0], &header, sizeof(header));
+        std::memcpy(&bytes[sizeof(header)], table.data(), columnCount * sizeof(TelemetryColumn));
+        for (std::uint32_t i = 0; i < columnCount; i++) {
+            if (rows > 0) {
+                std::memcpy(&bytes[table[i].offset], columns[i].data, rows * columns[i].elementSize);
+            }
+        }
+        return bytes;
+    }
+
+/** Make room for RESERVED_PIECES rows; a no-op once the columns have grown */
+    static void reserveColumns() {
+        lockTimes.reserve(RESERVED_PIECES);
+        pieces.reserve(RESERVED_PIECES);
+        xs.reserve(RESERVED_PIECES);
+        ys.reserve(RESERVED_PIECES);
+        lines.reserve(RESERVED_PIECES);
+        tSpins.reserve(RESERVED_PIECES);
+        combos.reserve(RESERVED_PIECES);
+        backToBacks.reserve(RESERVED_PIECES);
+        stackHeights.reserve(RESERVED_PIECES);
+        helds.reserve(RESERVED_PIECES);
+    }
+
+/** Start collecting a new session, writing out any unfinished one first */
+    void beginSession() {
+        endSession();
+        reserveColumns();
+        active = true;
+        startedAt = static_cast<std::int64_t>(std::time(nullptr));
+    }
+
+/** Append one locked piece */
+    void recordPiece(const PieceSample& sample) {
+        if (!active) return;
+        lockTimes.push_back(sample.lockTime);
+        pieces.push_back(sample.piece);
+        xs.push_back(sample.x);
+        ys.push_back(sample.y);
+        lines.push_back(sample.lines);
+        tSpins.push_back(sample.tSpin ? 1 : 0);
+        combos.push_back(sample.combo);
+        backToBacks.push_back(sample.backToBack ? 1 : 0);
+        stackHeights.push_back(sample.stackHeight);
+        helds.push_back(sample.held ? 1 : 0);
+    }
+
+/** Hand the finished session to the persistence worker */
+    void endSession() {
+        if (!active) return;
+        active = false;
+        if (lockTimes.empty()) return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(TELEMETRY_DIR, ec);
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s/%lld_%08x.tlm", TELEMETRY_DIR,
+                      static_cast<long long>(startedAt), gameSeed);
+        Persist::writeFile(name, serialize());
+        clearColumns();
+    }
+}
@@ -0,0 +1,34 @@
+/*
+ * Tetris Game - Per-piece session telemetry
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstdint>
+
+// Collects one row per locked piece into in-memory columns and writes the
+// session as a columnar .tlm file (see TelemetryFormat.h) when the game
+// ends, is abandoned, or the program exits. The columns are reserved for
+// RESERVED_PIECES rows when a session begins, so recording a piece only
+// reaches the heap in games longer than that.
+namespace Telemetry {
+    const int RESERVED_PIECES = 4096;
+
+    struct PieceSample {
+        float lockTime;
+        std::uint8_t piece;
+        std::int8_t x;
+        std::int8_t y;
+        std::uint8_t lines;
+        bool tSpin;
+        std::uint16_t combo;
+        bool backToBack;
+        std::uint8_t stackHeight;
+        bool held;
+    };
+
+    void beginSession();
+    void recordPiece(const PieceSample& sample);
+    void endSession();
+}
@@ -0,0 +1,55 @@
+/*
+ * Tetris Game - Session telemetry file format
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstdint>
+
+// telemetry/*.tlm layout (little-endian), one file per game session:
+//   TelemetryHeader
+//   TelemetryColumn[columnCount]
+//   column data, rowCount values per column, each column starting on a
+//   TELEMETRY_ALIGN boundary
+// One row per locked piece. Readers look columns up by name and only read
+// the ones they need.
+const char TELEMETRY_MAGIC[4] = {'T', 'L', 'M', 'C'};
+const std::uint32_t TELEMETRY_VERSION = 1;
+const std::uint32_t TELEMETRY_ALIGN = 8;
+const int TELEMETRY_NAME_LEN = 16;
+const int TELEMETRY_PLAYER_LEN = 32;
+
+struct TelemetryHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t rowCount;
+    std::uint32_t columnCount;
+    char player[TELEMETRY_PLAYER_LEN];
+    std::int64_t startedAt;
+    std::uint32_t seed;
+    std::uint8_t difficulty;
+    std::uint8_t mode;
+    std::uint16_t reserved;
+};
+
+struct TelemetryColumn {
+    char name[TELEMETRY_NAME_LEN];
+    std::uint32_t elementSize;
+    std::uint32_t reserved;
+    std::uint64_t offset;
+};
+
+// Column names written by the game
+//   lockTime    f32  seconds of play time when the piece locked
+//   piece       u8   piece index (I O T S Z J L)
+//   x, y        i8   board position of the piece's 4x4 box
+//   lines       u8   lines cleared by this piece
+//   tspin       u8   1 when the clear was a T-spin
+//   combo       u16  combo counter after the lock
+//   b2b         u8   back-to-back active after the lock
+//   stackHeight u8   highest filled row after the clear
+//   held        u8   1 when hold was used during this piece
+
+static_assert(sizeof(TelemetryHeader) == 64, "TelemetryHeader must be 64 bytes");
+static_assert(sizeof(TelemetryColumn) == 32, "TelemetryColumn must be 32 bytes");
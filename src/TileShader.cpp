@@ -0,0 +1,206 @@
+/*
+ * Tetris Game - Shader tile renderer implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "TileShader.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace TileShader {
+
+    // Type 0 is an empty cell, then the pieces, then garbage.
+    static const char TYPES[] = " IOTSZJL#";
+    static const int TYPE_COUNT = sizeof(TYPES) - 1;
+
+    // Power-of-two board texture, so texture coordinates mean the same
+    // whether or not the driver pads non-power-of-two textures.
+    static const unsigned TEXTURE_W = 16;
+    static const unsigned TEXTURE_H = 32;
+    static_assert(W <= TEXTURE_W && H <= TEXTURE_H, "board does not fit the tile texture");
+
+    // GLSL 1.10 so it runs on any GL 2 driver, Mesa's llvmpipe included.
+    // Tile layout matches UI::drawTile3D: a 3 px gap around a body with
+    // 3 px bevels, highlight top and left, shadow bottom and right on
+    // top of them, and a translucent shine near the top-left corner.
+    static const char* FRAGMENT_SOURCE = R"(
+#version 110
+uniform sampler2D board;
+uniform vec2 texels;
+uniform float tileSize;
+uniform float fromBoard;
+uniform vec4 palette[27];
+
+int typeOf(float channel) {
+    return int(channel * 255.0 + 0.5);
+}
+
+vec4 over(vec4 below, vec4 above) {
+    float a = above.a + below.a * (1.0 - above.a);
+    if (a <= 0.0) return vec4(0.0);
+    return vec4((above.rgb * above.a + below.rgb * below.a * (1.0 - above.a)) / a, a);
+}
+
+bool inside(vec2 p, vec2 lo, vec2 hi) {
+    return p.x >= lo.x && p.y >= lo.y && p.x < hi.x && p.y < hi.y;
+}
+
+vec4 tile(int type, vec2 p, float size) {
+    float edge = 1.5;
+    float bevel = 3.0;
+    float inner = size - 2.0 * edge;
+    if (!inside(p, vec2(edge), vec2(size - edge))) return vec4(0.0);
+    if (type == 0) return palette[0];
+
+    vec4 color = palette[type * 3];
+    if (p.x < edge + bevel || p.y < edge + bevel) color = palette[type * 3 + 1];
+    if (p.x >= size - edge - bevel || p.y >= size - edge - bevel) color = palette[type * 3 + 2];
+    vec2 shine = vec2(edge) + inner * vec2(0.2, 0.15);
+    if (inside(p, shine, shine + inner * vec2(0.3, 0.15))) {
+        color = over(color, vec4(palette[type * 3 + 1].rgb, 100.0 / 255.0));
+    }
+    return color;
+}
+
+vec4 ghost(int type, vec2 p, float size) {
+    bool outline = p.x < 1.0 || p.y < 1.0 || p.x >= size - 1.0 || p.y >= size - 1.0;
+    return vec4(palette[type * 3].rgb, (outline ? 120.0 : 60.0) / 255.0);
+}
+
+void main() {
+    if (fromBoard > 0.5) {
+        vec2 at = gl_TexCoord[0].xy * texels;
+        vec4 cell = texture2D(board, gl_TexCoord[0].xy);
+        vec2 p = fract(at) * tileSize;
+        vec4 color = tile(typeOf(cell.r), p, tileSize);
+        int shadow = typeOf(cell.g);
+        if (shadow > 0) color = over(color, ghost(shadow, p, tileSize));
+        gl_FragColor = color;
+    } else {
+        gl_FragColor = tile(typeOf(gl_Color.r), gl_TexCoord[0].xy, gl_Color.b * 255.0);
+    }
+}
+)";
+
+    static bool enabled = true;
+    static bool loaded = false;
+    static sf::Shader shader;
+    static sf::Texture boardTexture;
+    static std::uint8_t texels[TEXTURE_W * TEXTURE_H * 4];
+
+    static int typeOf(char c) {
+        const char* found = std::strchr(TYPES + 1, c);
+        return (c != '\0' && found) ? static_cast<int>(found - TYPES) : 0;
+    }
+
+/** Cell type and size travel in the vertex colour; the position in the tile in its texture coordinates */
+    static void appendQuad(sf::Vertex* out, float px, float py, float size, char c) {
+        sf::Color attributes(static_cast<std::uint8_t>(typeOf(c)), 0,
+                             static_cast<std::uint8_t>(size < 255.f ? size : 255.f));
+        const sf::Vector2f corners[6] = {{0.f, 0.f}, {size, 0.f}, {0.f, size},
+                                         {0.f, size}, {size, 0.f}, {size, size}};
+        for (int i = 0; i < 6; i++) {
+            out[i].position = {px + corners[i].x, py + corners[i].y};
+            out[i].color = attributes;
+            out[i].texCoords = corners[i];
+        }
+    }
+
+    void setEnabled(bool on) {
+        enabled = on;
+    }
+
+/** Compile the shader and make the board texture; needs the render thread's active context */
+    bool load() {
+        loaded = false;
+        if (!enabled || !sf::Shader::isAvailable()) return false;
+        if (!shader.loadFromMemory(FRAGMENT_SOURCE, sf::Shader::Type::Fragment) ||
+            !boardTexture.resize({TEXTURE_W, TEXTURE_H})) {
+            std::fprintf(stderr, "Tile shader unavailable, drawing tiles with shapes\n");
+            return false;
+        }
+
+        sf::Glsl::Vec4 palette[TYPE_COUNT * 3];
+        for (int t = 0; t < TYPE_COUNT; t++) {
+            palette[t * 3] = sf::Glsl::Vec4(getColor(TYPES[t]));
+            palette[t * 3 + 1] = sf::Glsl::Vec4(getHighlightColor(TYPES[t]));
+            palette[t * 3 + 2] = sf::Glsl::Vec4(getShadowColor(TYPES[t]));
+        }
+        shader.setUniformArray("palette", palette, TYPE_COUNT * 3);
+        shader.setUniform("board", boardTexture);
+        shader.setUniform("texels", sf::Glsl::Vec2(static_cast<float>(TEXTURE_W), static_cast<float>(TEXTURE_H)));
+        shader.setUniform("tileSize", static_cast<float>(TILE_SIZE));
+        loaded = true;
+        return true;
+    }
+
+/** Free the shader and texture while the context that made them is still current */
+    void unload() {
+        loaded = false;
+        shader = sf::Shader();
+        boardTexture = sf::Texture();
+    }
+
+    bool active() {
+        return loaded;
+    }
+
+/** The whole field, ghost included, in one draw of one quad */
+    void drawField(sf::RenderTarget& target, sf::Vector2f origin, const char (&cells)[H][W],
+                   const Piece* ghost, int ghostX, int ghostY) {
+        for (int i = 0; i < H; i++) {
+            for (int j = 0; j < W; j++) {
+                std::uint8_t* texel = &texels[(i * TEXTURE_W + j) * 4];
+                texel[0] = static_cast<std::uint8_t>(typeOf(cells[i][j]));
+                texel[1] = 0;
+            }
+        }
+        if (ghost) {
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 4; j++) {
+                    int row = ghostY + i, col = ghostX + j;
+                    if (ghost->shape[i][j] == ' ' || row < 0 || row >= H || col < 0 || col >= W) continue;
+                    texels[(row * TEXTURE_W + col) * 4 + 1] = static_cast<std::uint8_t>(typeOf(ghost->shape[i][j]));
+                }
+            }
+        }
+        boardTexture.update(texels);
+
+        const float w = static_cast<float>(W * TILE_SIZE), h = static_cast<float>(H * TILE_SIZE);
+        const sf::Vertex quad[4] = {
+            {origin, sf::Color::White, {0.f, 0.f}},
+            {{origin.x + w, origin.y}, sf::Color::White, {static_cast<float>(W), 0.f}},
+            {{origin.x, origin.y + h}, sf::Color::White, {0.f, static_cast<float>(H)}},
+            {{origin.x + w, origin.y + h}, sf::Color::White, {static_cast<float>(W), static_cast<float>(H)}},
+        };
+        shader.setUniform("fromBoard", 1.f);
+        sf::RenderStates states(&shader);
+        states.texture = &boardTexture;
+        target.draw(quad, 4, sf::PrimitiveType::TriangleStrip, states);
+    }
+
+/** A piece's cells as one quad each, in one draw */
+    void drawPiece(sf::RenderTarget& target, const Piece& piece, sf::Vector2f origin, float size) {
+        sf::Vertex vertices[16 * 6];
+        int count = 0;
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                if (piece.shape[i][j] == ' ') continue;
+                appendQuad(&vertices[count], origin.x + j * size, origin.y + i * size, size, piece.shape[i][j]);
+                count += 6;
+            }
+        }
+        if (count == 0) return;
+        shader.setUniform("fromBoard", 0.f);
+        target.draw(vertices, count, sf::PrimitiveType::Triangles, sf::RenderStates(&shader));
+    }
+
+    void drawTile(sf::RenderTarget& target, float px, float py, float size, char c) {
+        sf::Vertex vertices[6];
+        appendQuad(vertices, px, py, size, c);
+        shader.setUniform("fromBoard", 0.f);
+        target.draw(vertices, 6, sf::PrimitiveType::Triangles, sf::RenderStates(&shader));
+    }
+}
@@ -0,0 +1,31 @@
+/*
+ * Tetris Game - Shader tile renderer
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Config.h"
+#include "Piece.h"
+
+// Draws tiles with one fragment shader instead of six rectangles each.
+// The shader works out a tile's body, four bevels and shine from the
+// tile's type and the pixel's position in it, with the colours of every
+// type in a palette uniform. The playfield is uploaded as a small texture
+// holding each cell's type and ghost flag, then drawn as a single quad.
+// Loose tiles (the active piece, previews) are one quad per cell with the
+// type in the vertex colour. load() and unload() run on the render thread
+// with its context active. Without shader support, or with
+// --classic-tiles, active() is false and the UI draws tiles the old way.
+namespace TileShader {
+    void setEnabled(bool enabled);
+    bool load();
+    void unload();
+    bool active();
+
+    void drawField(sf::RenderTarget& target, sf::Vector2f origin, const char (&cells)[H][W],
+                   const Piece* ghost, int ghostX, int ghostY);
+    void drawPiece(sf::RenderTarget& target, const Piece& piece, sf::Vector2f origin, float size);
+    void drawTile(sf::RenderTarget& target, float px, float py, float size, char c);
+}
@@ -0,0 +1,154 @@
+/*
+ * Tetris Game - Profile training run implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Training.h"
+#include "Game.h"
+#include "Jobs.h"
+#include "Render.h"
+#include "Replay.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace Training {
+
+    // One replay's trip through the frontend; a negative length plays the
+    // replay to its end. The last PLAYING step shows the game-over screen.
+    struct Step {
+        GameState state;
+        float seconds;
+    };
+
+    static const Step STEPS[] = {
+        {GameState::MENU, 0.5f},
+        {GameState::HOWTOPLAY, 0.5f},
+        {GameState::SETTINGS, 0.5f},
+        {GameState::PLAYING, -1.f},
+        {GameState::PAUSED, 0.5f},
+        {GameState::PLAYING, 1.f},
+    };
+    static const int STEP_COUNT = sizeof(STEPS) / sizeof(STEPS[0]);
+
+    static std::vector<Replay::Recording> corpus;
+    static SettingsSnapshot savedSettings;
+    static bool started = false;
+    static bool running = false;
+    static std::size_t replay = 0;
+    static int step = 0;
+    static float stepTime = 0.f;
+    static Replay::Cursor cursor;
+    static double playClock = 0.0;
+
+    static int reproduced = 0;
+    static long long simTicks = 0;
+    static double simSeconds = 0.0;
+    static std::chrono::steady_clock::time_point frontendStart;
+
+    static void enter(int index) {
+        step = index;
+        stepTime = 0.f;
+        if (STEPS[step].seconds < 0.f) {
+            Replay::start(corpus[replay], cursor);
+            playClock = 0.0;
+        }
+    }
+
+/** Load the corpus and time it headless; false when dir holds no usable replay */
+    bool start(const std::string& dir) {
+        for (const std::string& path : Replay::list(dir)) {
+            Replay::Recording recording;
+            if (Replay::load(path, recording)) {
+                corpus.push_back(std::move(recording));
+            } else {
+                std::fprintf(stderr, "Training: skipping unreadable replay %s\n", path.c_str());
+            }
+        }
+        if (corpus.empty()) {
+            std::fprintf(stderr, "Training: no replays in %s\n", dir.c_str());
+            return false;
+        }
+        saveSettingsSnapshot(savedSettings);
+
+        // Headless passes: no sounds, particles, telemetry or saved scores.
+        int count = static_cast<int>(corpus.size());
+        std::vector<char> matches(count, 0);
+        effectsEnabled = false;
+        auto begin = std::chrono::steady_clock::now();
+        Jobs::parallelFor(0, count * HEADLESS_PASSES, 1, [&](int job) {
+            bool same = Replay::run(corpus[job % count]);
+            if (job < count) matches[job] = same;
+        });
+        simSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        effectsEnabled = true;
+        restoreSettingsSnapshot(savedSettings);
+
+        for (int i = 0; i < count; i++) {
+            simTicks += Replay::ticks(corpus[i]) * HEADLESS_PASSES;
+            reproduced += matches[i];
+        }
+
+        started = running = true;
+        replay = 0;
+        enter(0);
+        frontendStart = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool active() {
+        return running;
+    }
+
+/** Advance the script by one main-loop tick and set the screen; false once every replay has run */
+    bool update(float dt, GameState& state) {
+        if (!running) return false;
+        stepTime += dt;
+        bool finished;
+        if (STEPS[step].seconds < 0.f) {
+            playClock += dt * SPEED;
+            finished = !Replay::play(corpus[replay], cursor, playClock);
+        } else {
+            finished = stepTime >= STEPS[step].seconds;
+        }
+
+        if (finished) {
+            if (step + 1 < STEP_COUNT) {
+                enter(step + 1);
+            } else if (++replay < corpus.size()) {
+                enter(0);
+            } else {
+                running = false;
+                return false;
+            }
+        }
+        state = STEPS[step].state;
+        return true;
+    }
+
+/** Put the player's settings back and print the report; call after Render::stop */
+    void finish() {
+        if (!started) return;
+        started = running = false;
+        restoreSettingsSnapshot(savedSettings);
+
+        int count = static_cast<int>(corpus.size());
+        int games = count * HEADLESS_PASSES;
+        unsigned threads = Jobs::workerCount() + 1;
+        double frontendSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - frontendStart).count();
+        Render::Timings draw = Render::timings();
+
+        std::printf("Training: %d replays, %d reproduce their recorded games\n", count, reproduced);
+        if (reproduced < count) {
+            std::printf("  some replays are stale after a rules change; re-record them with ./corpus\n");
+        }
+        std::printf("  simulation: %d games, %lld ticks in %.2f s on %u threads: %.2f M ticks/s, %.1f games/s\n",
+                    games, simTicks, simSeconds, threads, simTicks / simSeconds / 1e6, games / simSeconds);
+        std::printf("  frontend:   %.1f s, %d frames, draw mean %.2f ms, p50 %.2f ms, p99 %.2f ms, max %.2f ms (%s tiles)\n",
+                    frontendSeconds, draw.frames, draw.meanMs, draw.p50Ms, draw.p99Ms, draw.maxMs,
+                    draw.shaderTiles ? "shader" : "classic");
+        std::fflush(stdout);
+        corpus.clear();
+    }
+}
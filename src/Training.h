@@ -0,0 +1,26 @@
+/*
+ * Tetris Game - Profile training run
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+#include <string>
+
+// --train <dir> plays the replay corpus in dir as the workload for a
+// profile-guided build, and times it so builds can be compared. First
+// every replay runs headless on all job threads (the simulation alone);
+// then the main loop hands each one to update(): the menu, how-to-play
+// and settings screens, the game at SPEED times its recorded pace with
+// its particles and line-clear effects, then the pause and game-over
+// screens, all drawn by the render thread. finish() prints the report.
+namespace Training {
+    const int HEADLESS_PASSES = 256;
+    const double SPEED = 4.0;
+
+    bool start(const std::string& dir);
+    bool active();
+    bool update(float dt, GameState& state);
+    void finish();
+}
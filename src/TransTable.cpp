@@ -0,0 +1,126 @@
+/*
+ * Tetris Game - Shared lock-free transposition table implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "TransTable.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+namespace TransTable {
+
+    static const int BUCKET_SLOTS = 4;
+
+    struct Slot {
+        std::atomic<std::uint64_t> check;
+        std::atomic<std::uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[BUCKET_SLOTS];
+    };
+
+    static std::unique_ptr<Bucket[]> buckets;
+    static std::size_t bucketMask = 0;
+    static std::atomic<std::uint8_t> generation{0};
+
+    static std::uint64_t pack(const Entry& entry) {
+        std::uint64_t data;
+        std::memcpy(&data, &entry, sizeof(data));
+        return data;
+    }
+
+    static Entry unpack(std::uint64_t data) {
+        Entry entry;
+        std::memcpy(&entry, &data, sizeof(entry));
+        return entry;
+    }
+
+    static_assert(sizeof(Entry) == sizeof(std::uint64_t), "Entry must pack into one word");
+
+/** Allocate the largest power-of-two bucket count that fits in the budget */
+    void init(std::size_t megabytes) {
+        std::size_t count = 1;
+        while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) count *= 2;
+        buckets.reset(new Bucket[count]);
+        bucketMask = count - 1;
+        clear();
+    }
+
+    void clear() {
+        for (std::size_t b = 0; buckets && b <= bucketMask; b++) {
+            for (Slot& slot : buckets[b].slots) {
+                slot.check.store(0, std::memory_order_relaxed);
+                slot.data.store(0, std::memory_order_relaxed);
+            }
+        }
+        generation.store(0, std::memory_order_relaxed);
+    }
+
+/** Age every stored entry so new results replace them first */
+    void newSearch() {
+        generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool probe(std::uint64_t key, Entry& out) {
+        if (!buckets) return false;
+        Bucket& bucket = buckets[key & bucketMask];
+        for (Slot& slot : bucket.slots) {
+            std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+            std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+            if ((check ^ data) == key) {
+                out = unpack(data);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void store(std::uint64_t key, std::int32_t score, std::uint16_t move, std::uint8_t depth) {
+        if (!buckets) return;
+        std::uint8_t now = generation.load(std::memory_order_relaxed);
+        Bucket& bucket = buckets[key & bucketMask];
+
+        Slot* target = nullptr;
+        int worst = 0x7FFFFFFF;
+        for (Slot& slot : bucket.slots) {
+            std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+            std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+            if ((check ^ data) == key) {
+                if (unpack(data).depth > depth && unpack(data).generation == now) return;
+                target = &slot;
+                break;
+            }
+            // Empty slots go first, then older generations, then shallow results.
+            Entry old = unpack(data);
+            int age = static_cast<std::uint8_t>(now - old.generation);
+            int value = (check | data) == 0 ? -1 : old.depth - 8 * age;
+            if (value < worst) {
+                worst = value;
+                target = &slot;
+            }
+        }
+
+        Entry entry = {score, move, depth, now};
+        std::uint64_t data = pack(entry);
+        target->data.store(data, std::memory_order_relaxed);
+        target->check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+/** Share of sampled slots written by the current search, in permille */
+    int occupancyPermille() {
+        if (!buckets) return 0;
+        std::uint8_t now = generation.load(std::memory_order_relaxed);
+        std::size_t sampled = bucketMask + 1 < 250 ? bucketMask + 1 : 250;
+        int used = 0;
+        for (std::size_t b = 0; b < sampled; b++) {
+            for (Slot& slot : buckets[b].slots) {
+                std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+                if (data != 0 && unpack(data).generation == now) used++;
+            }
+        }
+        return static_cast<int>(used * 1000 / (sampled * BUCKET_SLOTS));
+    }
+}
@@ -0,0 +1,35 @@
+/*
+ * Tetris Game - Shared lock-free transposition table
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// One fixed-size table of search results keyed by Zobrist position hash,
+// shared by every search on every thread. Each slot stores the key XORed
+// with its data next to the data itself, both as relaxed atomics; a probe
+// that reads a half-written slot fails the XOR check and counts as a miss,
+// so no locks are needed. Slots are grouped in 64-byte buckets of four;
+// a store replaces the same key, else the shallowest or oldest slot.
+// init() and clear() must not run while searches are using the table.
+namespace TransTable {
+    const std::size_t DEFAULT_MEGABYTES = 16;
+
+    struct Entry {
+        std::int32_t score;
+        std::uint16_t move;
+        std::uint8_t depth;
+        std::uint8_t generation;
+    };
+
+    void init(std::size_t megabytes = DEFAULT_MEGABYTES);
+    void clear();
+    void newSearch();
+
+    bool probe(std::uint64_t key, Entry& out);
+    void store(std::uint64_t key, std::int32_t score, std::uint16_t move, std::uint8_t depth);
+    int occupancyPermille();
+}
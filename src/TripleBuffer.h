@@ -0,0 +1,49 @@
+/*
+ * Tetris Game - Lock-free triple buffer
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include <atomic>
+
+// Latest-value handoff between exactly one writer thread and one reader
+// thread. The writer fills back() and publishes it; the reader takes the
+// newest published slot with update() and reads front() until the next
+// update. Neither side ever waits: the three slots are rotated through a
+// single atomic index, so an older unread slot is simply overwritten.
+template <typename T>
+class TripleBuffer {
+    static constexpr unsigned FRESH = 4;
+
+public:
+    /** Slot the writer fills before publish() */
+    T& back() { return slots_[back_]; }
+
+    /** Hand back() to the reader; false when the slot returned for writing was never read */
+    bool publish() {
+        unsigned previous = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+        back_ = previous & ~FRESH;
+        return (previous & FRESH) == 0;
+    }
+
+    /** Whether a slot was published since the reader's last update() */
+    bool fresh() const { return (middle_.load(std::memory_order_acquire) & FRESH) != 0; }
+
+    /** Take the newest published slot, returns false when nothing new arrived */
+    bool update() {
+        if (!fresh()) return false;
+        unsigned previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & ~FRESH;
+        return true;
+    }
+
+    /** Slot the reader owns until its next update() */
+    const T& front() const { return slots_[front_]; }
+
+private:
+    T slots_[3] = {};
+    unsigned back_ = 0;
+    alignas(64) std::atomic<unsigned> middle_{1};
+    alignas(64) unsigned front_ = 2;
+};
@@ -5,16 +5,20 @@
  */
 
 #include "UI.h"
+#include "AllocStats.h"
+#include "FixedString.h"
+#include "FrameArena.h"
 #include "Game.h"
 #include "Audio.h"
+#include "Leaderboard.h"
+#include "TileShader.h"
 #include <algorithm>
-#include <string>
-#include <vector>
+#include <cstdio>
 #include <cmath>
 
 using namespace sf;
 
-static void drawPanel(sf::RenderWindow& window, const sf::FloatRect& r) {
+static void drawPanel(sf::RenderTarget& window, const sf::FloatRect& r) {
     const float outline = 3.f;
     const float inset = outline;
 /** Render panel */
@@ -30,10 +34,18 @@ namespace UI {
 
 LineClearAnim lineClearAnim;
 
-std::vector<Particle> particles;
+// Fixed pool: a burst beyond MAX_PARTICLES drops the extra particles
+// instead of growing a vector in the middle of a line clear.
+static Particle particles[MAX_PARTICLES];
+static int particleCount = 0;
 
 /** Render tile3d */
-void drawTile3D(sf::RenderWindow& window, float px, float py, float size, char c) {
+void drawTile3D(sf::RenderTarget& window, float px, float py, float size, char c) {
+    if (TileShader::active()) {
+        TileShader::drawTile(window, px, py, size, c);
+        return;
+    }
+
     if (c == ' ') {
         sf::RectangleShape bg({size - 3.f, size - 3.f});
         bg.setPosition({px + 1.5f, py + 1.5f});
@@ -87,8 +99,148 @@ void drawTile3D(sf::RenderWindow& window, float px, float py, float size, char c
     window.draw(shine);
 }
 
+/** Versus: opponent's field as flat mini tiles in the stats column */
+void drawOpponentBoard(sf::RenderTarget& window, const sf::Font& font, const GameSnapshot& opponent, bool desynced) {
+    float panelX = 8.f;
+    float panelY = 12.f;
+    float panelW = STATS_W - 16.f;
+    float panelH = WINDOW_H - 24.f;
+
+    sf::RectangleShape bg({panelW, panelH});
+    bg.setPosition({panelX, panelY});
+    bg.setFillColor(sf::Color(15, 15, 25));
+    bg.setOutlineThickness(3.f);
+    bg.setOutlineColor(sf::Color(80, 80, 120));
+    window.draw(bg);
+
+    sf::Text title(font, "RIVAL", 26);
+    title.setFillColor(sf::Color::White);
+    float titleW = title.getLocalBounds().size.x;
+    title.setPosition({panelX + (panelW - titleW) / 2.f, panelY + 12.f});
+    window.draw(title);
+
+    const float mini = 10.f;
+    float boardX = panelX + (panelW - W * mini) / 2.f;
+    float boardY = panelY + 56.f;
+    sf::RectangleShape cell({mini - 1.f, mini - 1.f});
+    for (int i = 0; i < H; i++) {
+        for (int j = 0; j < W; j++) {
+            char c = opponent.board[i][j];
+            int pi = i - opponent.y;
+            int pj = j - opponent.x;
+            if (opponent.current.type >= 0 && pi >= 0 && pi < 4 && pj >= 0 && pj < 4 &&
+                opponent.current.shape[pi][pj] != ' ') {
+                c = opponent.current.shape[pi][pj];
+            }
+            cell.setPosition({boardX + j * mini, boardY + i * mini});
+            cell.setFillColor(getColor(c));
+            window.draw(cell);
+        }
+    }
+
+    float textY = boardY + H * mini + 16.f;
+    FixedString<24> scoreStr, linesStr, incomingStr;
+    sf::Text score(font, scoreStr.format("SCORE\n%d", opponent.gScore).c_str(), 16);
+    score.setFillColor(sf::Color(200, 200, 200));
+    score.setPosition({panelX + 10.f, textY});
+    window.draw(score);
+
+    sf::Text lines(font, linesStr.format("LINES\n%d", opponent.gLines).c_str(), 16);
+    lines.setFillColor(sf::Color(200, 200, 200));
+    lines.setPosition({panelX + 10.f, textY + 50.f});
+    window.draw(lines);
+
+    sf::Text incoming(font, incomingStr.format("INCOMING\n%d", pendingGarbage).c_str(), 16);
+    incoming.setFillColor(pendingGarbage > 0 ? sf::Color(255, 80, 80) : sf::Color(200, 200, 200));
+    incoming.setPosition({panelX + 10.f, textY + 100.f});
+    window.draw(incoming);
+
+    if (desynced) {
+        sf::Text desync(font, "DESYNC", 20);
+        desync.setFillColor(sf::Color::Red);
+        desync.setPosition({panelX + 10.f, textY + 160.f});
+        window.draw(desync);
+    }
+}
+
+/** Versus: shown while the relay looks for an opponent */
+void drawVersusWaiting(sf::RenderTarget& window, const sf::Font& font) {
+    RectangleShape overlay(Vector2f(WINDOW_W, WINDOW_H));
+    overlay.setFillColor(Color(0, 0, 0, 200));
+    window.draw(overlay);
+
+    Text waiting(font, "WAITING FOR OPPONENT...", 36);
+    waiting.setFillColor(Color::White);
+    float waitingW = waiting.getLocalBounds().size.x;
+    waiting.setPosition(sf::Vector2f{(WINDOW_W - waitingW) / 2.f, WINDOW_H / 2.f - 30.f});
+    window.draw(waiting);
+}
+
+/** Label a practice game with the undo key and how far back it can go */
+void drawPracticeBanner(sf::RenderTarget& window, const sf::Font& font, int undoDepth) {
+    FixedString<40> bannerStr;
+    Text banner(font, bannerStr.format("PRACTICE  Z: UNDO (%d)", undoDepth).c_str(), 18);
+    banner.setFillColor(Color(120, 220, 120));
+    banner.setPosition(sf::Vector2f{STATS_W + 8.f, 6.f});
+    window.draw(banner);
+}
+
+/** Label a watched game; there are no buttons because the viewer has no input */
+void drawSpectatorBanner(sf::RenderTarget& window, const sf::Font& font, bool gameOver) {
+    Text banner(font, "SPECTATING", 18);
+    banner.setFillColor(Color(255, 215, 0));
+    banner.setPosition(sf::Vector2f{STATS_W + 8.f, 6.f});
+    window.draw(banner);
+
+    if (!gameOver) return;
+
+    RectangleShape overlay(Vector2f(WINDOW_W, WINDOW_H));
+    overlay.setFillColor(Color(0, 0, 0, 160));
+    window.draw(overlay);
+
+    Text over(font, "GAME OVER", 48);
+    over.setFillColor(Color::Red);
+    float overW = over.getLocalBounds().size.x;
+    over.setPosition(sf::Vector2f{(WINDOW_W - overW) / 2.f, WINDOW_H / 2.f - 60.f});
+    window.draw(over);
+
+    Text waiting(font, "WAITING FOR THE NEXT GAME...", 20);
+    waiting.setFillColor(Color::White);
+    float waitingW = waiting.getLocalBounds().size.x;
+    waiting.setPosition(sf::Vector2f{(WINDOW_W - waitingW) / 2.f, WINDOW_H / 2.f + 10.f});
+    window.draw(waiting);
+}
+
+/** Exported replays: a label, and the final score instead of the game-over buttons */
+void drawReplayBanner(sf::RenderTarget& window, const sf::Font& font, bool gameOver) {
+    Text banner(font, "REPLAY", 18);
+    banner.setFillColor(Color(255, 215, 0));
+    banner.setPosition(sf::Vector2f{STATS_W + 8.f, 6.f});
+    window.draw(banner);
+
+    if (!gameOver) return;
+
+    RectangleShape overlay(Vector2f(WINDOW_W, WINDOW_H));
+    overlay.setFillColor(Color(0, 0, 0, 160));
+    window.draw(overlay);
+
+    Text over(font, "GAME OVER", 48);
+    over.setFillColor(Color::Red);
+    float overW = over.getLocalBounds().size.x;
+    over.setPosition(sf::Vector2f{(WINDOW_W - overW) / 2.f, WINDOW_H / 2.f - 60.f});
+    window.draw(over);
+
+    FixedString<48> score;
+    score.format("FINAL SCORE %d", gScore);
+    Text scoreText(font, score.c_str(), 24);
+    scoreText.setFillColor(Color::White);
+    float scoreW = scoreText.getLocalBounds().size.x;
+    scoreText.setPosition(sf::Vector2f{(WINDOW_W - scoreW) / 2.f, WINDOW_H / 2.f + 10.f});
+    window.draw(scoreText);
+}
+
 /** Process setFillColor */
-void drawPieceStats(sf::RenderWindow& window, const sf::Font& font) {
+void drawPieceStats(sf::RenderTarget& window, const sf::Font& font) {
 
     const char pieces[7] = {'I', 'O', 'T', 'S', 'Z', 'J', 'L'};
     const int shapes[7][4][4] = {
@@ -201,7 +353,7 @@ SidebarUI makeSidebarUI() {
     return ui;
 }
 
-static void drawHoldPreview(sf::RenderWindow& window, const SidebarUI& ui, const Piece* p) {
+static void drawHoldPreview(sf::RenderTarget& window, const SidebarUI& ui, const Piece* p) {
     if (!p) return;
     int minR = 4, minC = 4, maxR = -1, maxC = -1;
     for (int r = 0; r < 4; r++) {
@@ -233,9 +385,35 @@ static void drawHoldPreview(sf::RenderWindow& window, const SidebarUI& ui, const
     }
 }
 
-void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
+/** Fill in the sidebar's text from the current game */
+void formatSidebar(SidebarText& text, int score, int level, int lines) {
+    static int maxCombo = 0;
+    if (comboCount > maxCombo) maxCombo = comboCount;
+
+    int minutes = static_cast<int>(playTime) / 60;
+    int seconds = static_cast<int>(playTime) % 60;
+    float ppm = (playTime > 0) ? (totalPieces / playTime * 60.f) : 0.f;
+    float lpm = (playTime > 0) ? (lines / playTime * 60.f) : 0.f;
+
+    text = SidebarText();
+    text.topScore.format("%09d", highScore);
+    text.score.format("%09d", score);
+    text.level.format("%09d", level);
+    text.lines.format("%09d", lines);
+    text.time.format("Time: %02d:%02d", minutes, seconds);
+    text.pieces.format("Pieces: %d", totalPieces);
+    text.ppm.format("PPM: %.1f", ppm);
+    text.lpm.format("LPM: %.1f", lpm);
+    text.tetris.format("Tetris: %d", tetrisCount);
+    text.tSpin.format("T-Spin: %d", tSpinCount);
+    text.maxCombo.format("Max Combo: %d", maxCombo);
+}
+
+void drawSidebar(sf::RenderTarget& window, const SidebarUI& ui,
                  const sf::Font& font, int score, int level, int lines,
                  const Piece* next, Piece* const nextQueue[], const Piece* hold) {
+    SidebarText text;
+    formatSidebar(text, score, level, lines);
 
 /** Render sidebar */
     sf::RectangleShape bg({ui.w, ui.h});
@@ -342,9 +520,7 @@ void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
     topScoreLabel.setFillColor(sf::Color(255, 200, 100));
     topScoreLabel.setPosition({ui.topScoreBox.position.x + pad, ui.topScoreBox.position.y + pad});
     window.draw(topScoreLabel);
-    char topScoreStr[16];
-    snprintf(topScoreStr, 16, "%09d", highScore);
-    sf::Text topScoreVal(font, topScoreStr, valueSize);
+    sf::Text topScoreVal(font, text.topScore.c_str(), valueSize);
     topScoreVal.setFillColor(sf::Color(255, 200, 100));
     float topScoreValH = topScoreVal.getLocalBounds().size.y;
     topScoreVal.setPosition({ui.topScoreBox.position.x + pad, ui.topScoreBox.position.y + ui.topScoreBox.size.y - pad - topScoreValH - 4.f});
@@ -354,9 +530,7 @@ void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
     scoreLabel.setFillColor(sf::Color(255, 150, 100));
     scoreLabel.setPosition({ui.scoreBox.position.x + pad, ui.scoreBox.position.y + pad});
     window.draw(scoreLabel);
-    char scoreStr[16];
-    snprintf(scoreStr, 16, "%09d", score);
-    sf::Text scoreVal(font, scoreStr, valueSize);
+    sf::Text scoreVal(font, text.score.c_str(), valueSize);
     scoreVal.setFillColor(sf::Color(200, 200, 200));
     float scoreValH = scoreVal.getLocalBounds().size.y;
     scoreVal.setPosition({ui.scoreBox.position.x + pad, ui.scoreBox.position.y + ui.scoreBox.size.y - pad - scoreValH - 4.f});
@@ -366,9 +540,7 @@ void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
     levelLabel.setFillColor(sf::Color(100, 255, 100));
     levelLabel.setPosition({ui.levelBox.position.x + pad, ui.levelBox.position.y + pad});
     window.draw(levelLabel);
-    char levelStr[16];
-    snprintf(levelStr, 16, "%09d", level);
-    sf::Text levelVal(font, levelStr, valueSize);
+    sf::Text levelVal(font, text.level.c_str(), valueSize);
     levelVal.setFillColor(sf::Color(200, 200, 200));
     float levelValH = levelVal.getLocalBounds().size.y;
     levelVal.setPosition({ui.levelBox.position.x + pad, ui.levelBox.position.y + ui.levelBox.size.y - pad - levelValH - 4.f});
@@ -378,9 +550,7 @@ void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
     linesLabel.setFillColor(sf::Color(255, 100, 255));
     linesLabel.setPosition({ui.linesBox.position.x + pad, ui.linesBox.position.y + pad});
     window.draw(linesLabel);
-    char linesStr[16];
-    snprintf(linesStr, 16, "%09d", lines);
-    sf::Text linesVal(font, linesStr, valueSize);
+    sf::Text linesVal(font, text.lines.c_str(), valueSize);
     linesVal.setFillColor(sf::Color(200, 200, 200));
     float linesValH = linesVal.getLocalBounds().size.y;
     linesVal.setPosition({ui.linesBox.position.x + pad, ui.linesBox.position.y + ui.linesBox.size.y - pad - linesValH - 4.f});
@@ -396,55 +566,43 @@ void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
     float infoY = ui.statsBox.position.y + pad + 30.f;
     float lineHeight = 22.f;
 
-    int minutes = static_cast<int>(playTime) / 60;
-    int seconds = static_cast<int>(playTime) % 60;
-    char timeStr[20];
-    snprintf(timeStr, 20, "Time: %02d:%02d", minutes, seconds);
-    sf::Text timeText(font, timeStr, infoSize);
+    sf::Text timeText(font, text.time.c_str(), infoSize);
     timeText.setFillColor(sf::Color(200, 200, 200));
     timeText.setPosition({infoLabelX, infoY});
     window.draw(timeText);
     infoY += lineHeight;
 
-    sf::Text piecesText(font, "Pieces: " + std::to_string(totalPieces), infoSize);
+    sf::Text piecesText(font, text.pieces.c_str(), infoSize);
     piecesText.setFillColor(sf::Color(200, 200, 200));
     piecesText.setPosition({infoLabelX, infoY});
     window.draw(piecesText);
     infoY += lineHeight;
 
-    float ppm = (playTime > 0) ? (totalPieces / playTime * 60.f) : 0.f;
-    char ppmStr[20];
-    snprintf(ppmStr, 20, "PPM: %.1f", ppm);
-    sf::Text ppmText(font, ppmStr, infoSize);
+    sf::Text ppmText(font, text.ppm.c_str(), infoSize);
     ppmText.setFillColor(sf::Color(200, 200, 200));
     ppmText.setPosition({infoLabelX, infoY});
     window.draw(ppmText);
     infoY += lineHeight;
 
-    float lpm = (playTime > 0) ? (lines / playTime * 60.f) : 0.f;
-    char lpmStr[20];
-    snprintf(lpmStr, 20, "LPM: %.1f", lpm);
-    sf::Text lpmText(font, lpmStr, infoSize);
+    sf::Text lpmText(font, text.lpm.c_str(), infoSize);
     lpmText.setFillColor(sf::Color(200, 200, 200));
     lpmText.setPosition({infoLabelX, infoY});
     window.draw(lpmText);
     infoY += lineHeight;
 
-    sf::Text tetrisText(font, "Tetris: " + std::to_string(tetrisCount), infoSize);
+    sf::Text tetrisText(font, text.tetris.c_str(), infoSize);
     tetrisText.setFillColor(sf::Color(0, 240, 240));
     tetrisText.setPosition({infoLabelX, infoY});
     window.draw(tetrisText);
     infoY += lineHeight;
 
-    sf::Text tspinText(font, "T-Spin: " + std::to_string(tSpinCount), infoSize);
+    sf::Text tspinText(font, text.tSpin.c_str(), infoSize);
     tspinText.setFillColor(sf::Color(200, 100, 255));
     tspinText.setPosition({infoLabelX, infoY});
     window.draw(tspinText);
     infoY += lineHeight;
 
-    static int maxCombo = 0;
-    if (comboCount > maxCombo) maxCombo = comboCount;
-    sf::Text maxComboText(font, "Max Combo: " + std::to_string(maxCombo), infoSize);
+    sf::Text maxComboText(font, text.maxCombo.c_str(), infoSize);
     maxComboText.setFillColor(sf::Color(255, 150, 100));
     maxComboText.setPosition({infoLabelX, infoY});
     window.draw(maxComboText);
@@ -459,7 +617,7 @@ void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
 }
 
 /** Process setPosition */
-void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
+void drawSettingsScreen(sf::RenderTarget& window, const sf::Font& font) {
 
     Text settingsTitle(font);
     settingsTitle.setString("SETTINGS");
@@ -484,6 +642,7 @@ void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
     const float row4Y = 395.f;
     const float row5Y = 480.f;
     const float row6Y = 565.f;
+    const float row7Y = 630.f;
     const float backY = 700.f;
 
     Text musicLabel(font);
@@ -518,7 +677,7 @@ void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
     window.draw(musicRightArrow);
 
     Text musicValue(font);
-    musicValue.setString(std::to_string((int)musicVolume) + "%");
+    musicValue.setString(FixedString<8>().format("%d%%", (int)musicVolume).c_str());
     musicValue.setCharacterSize(24);
     musicValue.setFillColor(Color::White);
     musicValue.setPosition(sf::Vector2f{valueX, row1Y + 3.f});
@@ -556,7 +715,7 @@ void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
     window.draw(sfxRightArrow);
 
     Text sfxValue(font);
-    sfxValue.setString(std::to_string((int)sfxVolume) + "%");
+    sfxValue.setString(FixedString<8>().format("%d%%", (int)sfxVolume).c_str());
     sfxValue.setCharacterSize(24);
     sfxValue.setFillColor(Color::White);
     sfxValue.setPosition(sf::Vector2f{valueX, row2Y + 3.f});
@@ -595,7 +754,7 @@ void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
 
     Text brightnessValue(font);
     float brightnessPercent = ((brightness - 51.f) / (255.f - 51.f)) * 80.f + 20.f;
-    brightnessValue.setString(std::to_string((int)brightnessPercent) + "%");
+    brightnessValue.setString(FixedString<8>().format("%d%%", (int)brightnessPercent).c_str());
     brightnessValue.setCharacterSize(24);
     brightnessValue.setFillColor(Color::White);
     brightnessValue.setPosition(sf::Vector2f{valueX, row3Y + 3.f});
@@ -643,7 +802,7 @@ void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
     window.draw(dasRightArrow);
 
     Text dasValue(font);
-    dasValue.setString(std::to_string((int)dasMs) + "ms");
+    dasValue.setString(FixedString<8>().format("%dms", (int)dasMs).c_str());
     dasValue.setCharacterSize(24);
     dasValue.setFillColor(Color::White);
     dasValue.setPosition(sf::Vector2f{valueX, dasSliderY + 3.f});
@@ -691,7 +850,7 @@ void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
     window.draw(arrRightArrow);
 
     Text arrValue(font);
-    arrValue.setString(std::to_string((int)arrMs) + "ms");
+    arrValue.setString(FixedString<8>().format("%dms", (int)arrMs).c_str());
     arrValue.setCharacterSize(24);
     arrValue.setFillColor(Color::White);
     arrValue.setPosition(sf::Vector2f{valueX, arrSliderY + 3.f});
@@ -727,6 +886,36 @@ void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font) {
     ghostStatus.setPosition(sf::Vector2f{checkboxX + 50.f, row6Y + 3.f});
     window.draw(ghostStatus);
 
+    Text softDropLabel(font);
+    softDropLabel.setString("Instant Drop");
+    softDropLabel.setCharacterSize(28);
+    softDropLabel.setFillColor(Color::White);
+    softDropLabel.setPosition(sf::Vector2f{labelX, row7Y});
+    window.draw(softDropLabel);
+
+    RectangleShape softDropBox(Vector2f(35, 35));
+    softDropBox.setPosition(sf::Vector2f{checkboxX, row7Y - 2.f});
+    softDropBox.setFillColor(Color(80, 80, 80));
+    softDropBox.setOutlineThickness(3.f);
+    softDropBox.setOutlineColor(Color::White);
+    window.draw(softDropBox);
+
+    if (instantSoftDrop) {
+        Text checkMark(font);
+        checkMark.setString("X");
+        checkMark.setCharacterSize(28);
+        checkMark.setFillColor(Color::Green);
+        checkMark.setPosition(sf::Vector2f{checkboxX + 7.f, row7Y - 2.f});
+        window.draw(checkMark);
+    }
+
+    Text softDropStatus(font);
+    softDropStatus.setString(instantSoftDrop ? "ON" : "OFF");
+    softDropStatus.setCharacterSize(24);
+    softDropStatus.setFillColor(instantSoftDrop ? Color::Green : Color::Red);
+    softDropStatus.setPosition(sf::Vector2f{checkboxX + 50.f, row7Y + 3.f});
+    window.draw(softDropStatus);
+
     const float backBtnW = 280.f;
     const float backBtnH = 65.f;
     const float backBtnX = (WINDOW_W - backBtnW) / 2.f;
@@ -759,6 +948,7 @@ void handleSettingsClick(sf::Vector2i mousePos) {
     const float row4Y = 395.f;
     const float row5Y = 480.f;
     const float row6Y = 565.f;
+    const float row7Y = 630.f;
 
     auto inRange = [&](float minX, float maxX, float minY, float maxY) {
         return mousePos.x >= minX && mousePos.x <= maxX && mousePos.y >= minY && mousePos.y <= maxY;
@@ -872,24 +1062,48 @@ void handleSettingsClick(sf::Vector2i mousePos) {
             Audio::playToggleOff();
         }
     }
+
+    if (inRange(checkboxX, checkboxX + 35, row7Y - 5, row7Y + 40)) {
+        instantSoftDrop = !instantSoftDrop;
+        if (instantSoftDrop) {
+            Audio::playToggleOn();
+        } else {
+            Audio::playToggleOff();
+        }
+    }
 }
 
 /** Process playToggleOff */
-void drawGameOverScreen(sf::RenderWindow& window, const sf::Font& font) {
+void drawGameOverScreen(sf::RenderTarget& window, const sf::Font& font, int outcome, int rankedGames) {
 
     RectangleShape overlay(Vector2f(WINDOW_W, WINDOW_H));
     overlay.setFillColor(Color(0, 0, 0, 200));
     window.draw(overlay);
 
     const float fullW = WINDOW_W;
+    const bool versus = gameMode == GameMode::VERSUS;
+    const bool practice = gameMode == GameMode::PRACTICE;
     Text gameOverText(font);
-    gameOverText.setString("GAME OVER");
+    gameOverText.setString(!versus ? "GAME OVER" : outcome > 0 ? "YOU WIN" : outcome < 0 ? "YOU LOSE" : "DRAW");
     gameOverText.setCharacterSize(70);
-    gameOverText.setFillColor(Color::Red);
+    gameOverText.setFillColor(versus && outcome > 0 ? Color(255, 215, 0) : Color::Red);
     float goWidth = gameOverText.getLocalBounds().size.x;
     gameOverText.setPosition(sf::Vector2f{(fullW - goWidth) / 2.f, 220.f});
     window.draw(gameOverText);
 
+    static const char* difficultyNames[] = {"EASY", "NORMAL", "HARD"};
+    const char* difficultyName = difficultyNames[static_cast<int>(difficulty)];
+    const char* standing = practice ? "PRESS Z TO UNDO" : gameOverRank > 0
+        ? FrameArena::format("RANK #%d OF %d %s GAMES", gameOverRank, rankedGames, difficultyName)
+        : FrameArena::format("OUTSIDE TOP %d OF %d %s GAMES", Leaderboard::TOP_N, rankedGames, difficultyName);
+    Text rankText(font);
+    rankText.setString(standing);
+    rankText.setCharacterSize(22);
+    rankText.setFillColor(gameOverRank > 0 || practice ? Color(255, 215, 0) : Color(200, 200, 200));
+    float rankWidth = rankText.getLocalBounds().size.x;
+    rankText.setPosition(sf::Vector2f{(fullW - rankWidth) / 2.f, 302.f});
+    if (!versus) window.draw(rankText);
+
     const float goBtnW = 280.f;
     const float goBtnH = 65.f;
     const float goBtnX = (fullW - goBtnW) / 2.f;
@@ -932,7 +1146,7 @@ void drawGameOverScreen(sf::RenderWindow& window, const sf::Font& font) {
 }
 
 /** Process getLocalBounds */
-void drawBrightnessOverlay(sf::RenderWindow& window) {
+void drawBrightnessOverlay(sf::RenderTarget& window) {
     if (brightness < 255.f) {
         RectangleShape darkenOverlay(Vector2f(WINDOW_W, WINDOW_H));
         darkenOverlay.setFillColor(Color(0, 0, 0, static_cast<uint8_t>(255 - brightness)));
@@ -940,8 +1154,71 @@ void drawBrightnessOverlay(sf::RenderWindow& window) {
     }
 }
 
+/** Render the font-less progress bar shown while assets load */
+void drawLoadingScreen(sf::RenderTarget& window, float progress) {
+    const float barW = 400.f;
+    const float barH = 24.f;
+    const float barX = (WINDOW_W - barW) / 2.f;
+    const float barY = (WINDOW_H - barH) / 2.f;
+
+    RectangleShape frame({barW, barH});
+    frame.setPosition({barX, barY});
+    frame.setFillColor(Color(15, 15, 25));
+    frame.setOutlineThickness(3.f);
+    frame.setOutlineColor(Color(80, 80, 120));
+    window.draw(frame);
+
+    RectangleShape fill({barW * std::max(0.f, std::min(1.f, progress)), barH});
+    fill.setPosition({barX, barY});
+    fill.setFillColor(Color::Cyan);
+    window.draw(fill);
+}
+
+/** Debug overlay (F3): heap calls and bytes per frame by subsystem over the last window */
+void drawAllocOverlay(sf::RenderTarget& window, const sf::Font& font,
+                      const AllocStats::Totals& counts, int frames, float frameMs) {
+    if (frames <= 0) return;
+    char text[512];
+    int used = std::snprintf(text, sizeof(text), "%.2f ms/frame\n%-10s %7s %7s\n",
+                             frameMs, "per frame", "allocs", "bytes");
+    for (int i = 0; i < AllocStats::SUBSYSTEM_COUNT && used < static_cast<int>(sizeof(text)); i++) {
+        const AllocStats::Counts& c = counts.subsystems[i];
+        used += std::snprintf(text + used, sizeof(text) - used, "%-10s %7.1f %7.0f\n", AllocStats::name(i),
+                              static_cast<double>(c.calls) / frames, static_cast<double>(c.bytes) / frames);
+    }
+
+    RectangleShape panel({270.f, 190.f});
+    panel.setPosition({8.f, 8.f});
+    panel.setFillColor(Color(0, 0, 0, 190));
+    window.draw(panel);
+
+    Text stats(font, text, 14);
+    stats.setFillColor(Color(120, 255, 120));
+    stats.setPosition({16.f, 12.f});
+    window.draw(stats);
+}
+
+// Every character size the screens use, and whether it is also drawn bold.
+struct FontFace {
+    unsigned int size;
+    bool bold;
+};
+
+static const FontFace uiFaces[] = {
+    {14, false}, {16, false}, {18, false}, {20, false}, {22, false}, {24, false},
+    {26, false}, {28, false}, {28, true}, {30, false}, {32, false}, {36, false},
+    {48, false}, {70, false}, {70, true}, {80, true},
+};
+
+/** Rasterize printable ASCII at every UI size, so no screen's first frame waits on FreeType */
+void prewarmGlyphs(const sf::Font& font) {
+    for (const FontFace& face : uiFaces) {
+        for (char32_t c = 0x20; c < 0x7F; c++) font.getGlyph(c, face.size, face.bold);
+    }
+}
+
 /** Process setFillColor */
-void drawMenu(sf::RenderWindow& window, const sf::Font& font) {
+void drawMenu(sf::RenderTarget& window, const sf::Font& font) {
     const float fullW = WINDOW_W;
 
     Text title(font, "TETRIS", 80);
@@ -982,16 +1259,27 @@ void drawMenu(sf::RenderWindow& window, const sf::Font& font) {
         window.draw(diffText);
     }
 
-    RectangleShape startBtn({btnW, btnH});
+    const float halfBtnW = (btnW - 12.f) / 2.f;
+    RectangleShape startBtn({halfBtnW, btnH});
     startBtn.setPosition({btnX, 360.f});
     startBtn.setFillColor(Color(0, 150, 0));
     window.draw(startBtn);
-    Text startText(font, "START", 32);
+    Text startText(font, "START", 20);
     startText.setFillColor(Color::White);
     float startTxtW = startText.getLocalBounds().size.x;
-    startText.setPosition({btnX + (btnW - startTxtW) / 2.f, 372.f});
+    startText.setPosition({btnX + (halfBtnW - startTxtW) / 2.f, 380.f});
     window.draw(startText);
 
+    RectangleShape practiceBtn({halfBtnW, btnH});
+    practiceBtn.setPosition({btnX + halfBtnW + 12.f, 360.f});
+    practiceBtn.setFillColor(Color(0, 120, 90));
+    window.draw(practiceBtn);
+    Text practiceText(font, "PRACTICE", 20);
+    practiceText.setFillColor(Color::White);
+    float practiceTxtW = practiceText.getLocalBounds().size.x;
+    practiceText.setPosition({btnX + halfBtnW + 12.f + (halfBtnW - practiceTxtW) / 2.f, 380.f});
+    window.draw(practiceText);
+
     RectangleShape howToBtn({btnW, btnH});
     howToBtn.setPosition({btnX, 445.f});
     howToBtn.setFillColor(Color(0, 100, 180));
@@ -1046,11 +1334,16 @@ void handleMenuClick(sf::Vector2i mousePos, GameState& state, GameState& previou
         }
     }
 
-    if (mousePos.x >= btnX && mousePos.x <= btnX + btnW &&
-        mousePos.y >= 360 && mousePos.y <= 425) {
-        Audio::playStartGame();
-        resetGame();
-        state = GameState::PLAYING;
+    const float halfBtnW = (btnW - 12.f) / 2.f;
+    if (mousePos.y >= 360 && mousePos.y <= 425) {
+        bool start = mousePos.x >= btnX && mousePos.x <= btnX + halfBtnW;
+        bool practice = mousePos.x >= btnX + halfBtnW + 12.f && mousePos.x <= btnX + btnW;
+        if (start || practice) {
+            Audio::playStartGame();
+            gameMode = practice ? GameMode::PRACTICE : GameMode::MARATHON;
+            resetGame();
+            state = GameState::PLAYING;
+        }
     }
 
     if (mousePos.x >= btnX && mousePos.x <= btnX + btnW &&
@@ -1074,7 +1367,7 @@ void handleMenuClick(sf::Vector2i mousePos, GameState& state, GameState& previou
 }
 
 /** Render pausescreen */
-void drawPauseScreen(sf::RenderWindow& window, const sf::Font& font) {
+void drawPauseScreen(sf::RenderTarget& window, const sf::Font& font) {
     const float fullW = WINDOW_W;
 
     RectangleShape overlay(Vector2f(fullW, WINDOW_H));
@@ -1156,7 +1449,7 @@ void updateLineClearAnim(float dt) {
     }
 }
 
-void drawLineClearAnim(sf::RenderWindow& window) {
+void drawLineClearAnim(sf::RenderTarget& window) {
     if (!lineClearAnim.active) return;
 
     float alpha = (1.f - lineClearAnim.timer / 0.3f) * 255.f;
@@ -1173,10 +1466,11 @@ void drawLineClearAnim(sf::RenderWindow& window) {
 }
 
 /** Process setFillColor */
-void drawCombo(sf::RenderWindow& window, const sf::Font& font) {
+void drawCombo(sf::RenderTarget& window, const sf::Font& font) {
     if (comboCount <= 1) return;
 
-    Text comboText(font, "COMBO x" + std::to_string(comboCount), 30);
+    FixedString<24> comboStr;
+    Text comboText(font, comboStr.format("COMBO x%d", comboCount).c_str(), 30);
     comboText.setFillColor(Color::Yellow);
     float cw = comboText.getLocalBounds().size.x;
     comboText.setPosition({STATS_W + (PLAY_W_PX - cw) / 2.f, WINDOW_H / 2.f - 50.f});
@@ -1185,8 +1479,8 @@ void drawCombo(sf::RenderWindow& window, const sf::Font& font) {
 
 /** Process getLocalBounds */
 void addParticles(float x, float y, sf::Color color, int count) {
-    for (int i = 0; i < count; i++) {
-        Particle p;
+    for (int i = 0; i < count && particleCount < MAX_PARTICLES; i++) {
+        Particle& p = particles[particleCount++];
         p.x = x;
         p.y = y;
 
@@ -1196,30 +1490,32 @@ void addParticles(float x, float y, sf::Color color, int count) {
         p.vy = sin(angle) * speed - 50.f;
         p.life = 0.5f + (rand() % 100) / 200.f;
         p.color = color;
-        particles.push_back(p);
     }
 }
 
 /** Process push_back */
 void updateParticles(float dt) {
-    for (auto it = particles.begin(); it != particles.end();) {
-        it->x += it->vx * dt;
-        it->y += it->vy * dt;
-        it->vy += 200.f * dt;
-        it->life -= dt;
-
-        if (it->life <= 0.f) {
-            it = particles.erase(it);
+    for (int i = 0; i < particleCount;) {
+        Particle& p = particles[i];
+        p.x += p.vx * dt;
+        p.y += p.vy * dt;
+        p.vy += 200.f * dt;
+        p.life -= dt;
+
+        if (p.life <= 0.f) {
+            p = particles[--particleCount];
         } else {
-            ++it;
+            i++;
         }
     }
 }
 
 /** Render particles */
-void drawParticles(sf::RenderWindow& window) {
-    for (const auto& p : particles) {
-        sf::CircleShape circle(2.f);
+void drawParticles(sf::RenderTarget& window) {
+    // One shape moved around keeps its vertex storage between particles.
+    static sf::CircleShape circle(2.f);
+    for (int i = 0; i < particleCount; i++) {
+        const Particle& p = particles[i];
         circle.setPosition({p.x, p.y});
         sf::Color c = p.color;
         c.a = static_cast<uint8_t>(p.life * 255.f);
@@ -1229,7 +1525,7 @@ void drawParticles(sf::RenderWindow& window) {
 }
 
 /** Process setFillColor */
-void drawSoftDropTrail(sf::RenderWindow& window, const Piece* piece, int px, int py, bool isActive) {
+void drawSoftDropTrail(sf::RenderTarget& window, const Piece* piece, int px, int py, bool isActive) {
     if (!isActive || !piece) return;
 
     for (int i = 0; i < 4; i++) {
@@ -1252,7 +1548,7 @@ void drawSoftDropTrail(sf::RenderWindow& window, const Piece* piece, int px, int
 }
 
 /** Render howtoplay */
-void drawHowToPlay(sf::RenderWindow& window, const sf::Font& font) {
+void drawHowToPlay(sf::RenderTarget& window, const sf::Font& font) {
     const float fullW = WINDOW_W;
 
     RectangleShape bg(Vector2f(fullW, WINDOW_H));
@@ -1271,7 +1567,8 @@ void drawHowToPlay(sf::RenderWindow& window, const sf::Font& font) {
     float y = 130.f;
     float lineH = 28.f;
 
-    auto drawSection = [&](float x, float& yPos, const std::string& header, const std::vector<std::string>& lines) {
+    // Section lines are literals listed on the stack; nothing is copied.
+    auto drawSection = [&](float x, float& yPos, const char* header, std::initializer_list<const char*> lines) {
         Text headerText(font, header, 28);
         headerText.setFillColor(Color(255, 200, 50));
         headerText.setStyle(Text::Bold);
@@ -1279,7 +1576,7 @@ void drawHowToPlay(sf::RenderWindow& window, const sf::Font& font) {
         window.draw(headerText);
         yPos += lineH + 4.f;
 
-        for (const auto& line : lines) {
+        for (const char* line : lines) {
             Text lineText(font, line, 18);
             lineText.setFillColor(Color::White);
             lineText.setPosition({x + 10.f, yPos});
@@ -7,8 +7,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "Config.h"
+#include "FixedString.h"
 #include "Piece.h"
 
+struct GameSnapshot;
+namespace AllocStats { struct Totals; }
+
 
 
 // Types and structures
@@ -25,6 +29,13 @@ struct SidebarUI {
     sf::FloatRect statsBox;
 };
 
+// Every number the sidebar shows, as text. drawSidebar formats it first
+// and then draws; bench allocs formats it once per frame as well.
+struct SidebarText {
+    FixedString<16> topScore, score, level, lines;
+    FixedString<24> time, pieces, ppm, lpm, tetris, tSpin, maxCombo;
+};
+
 struct LineClearAnim {
     bool active = false;
     float timer = 0.f;
@@ -38,36 +49,49 @@ namespace UI {
 
 
 // UI functions
-    void drawTile3D(sf::RenderWindow& window, float px, float py, float size, char c);
+    void drawTile3D(sf::RenderTarget& window, float px, float py, float size, char c);
 
-    void drawPieceStats(sf::RenderWindow& window, const sf::Font& font);
+    void drawPieceStats(sf::RenderTarget& window, const sf::Font& font);
+    void drawOpponentBoard(sf::RenderTarget& window, const sf::Font& font, const GameSnapshot& opponent, bool desynced);
+    void drawVersusWaiting(sf::RenderTarget& window, const sf::Font& font);
+    void drawSpectatorBanner(sf::RenderTarget& window, const sf::Font& font, bool gameOver);
+    void drawReplayBanner(sf::RenderTarget& window, const sf::Font& font, bool gameOver);
+    void drawPracticeBanner(sf::RenderTarget& window, const sf::Font& font, int undoDepth);
 
     SidebarUI makeSidebarUI();
-    void drawSidebar(sf::RenderWindow& window, const SidebarUI& ui,
+    void formatSidebar(SidebarText& text, int score, int level, int lines);
+    void drawSidebar(sf::RenderTarget& window, const SidebarUI& ui,
                      const sf::Font& font, int score, int level, int lines,
                      const Piece* next, Piece* const nextQueue[], const Piece* hold);
 
-    void drawSettingsScreen(sf::RenderWindow& window, const sf::Font& font);
+    void drawSettingsScreen(sf::RenderTarget& window, const sf::Font& font);
     void handleSettingsClick(sf::Vector2i mousePos);
 
-    void drawMenu(sf::RenderWindow& window, const sf::Font& font);
+    void drawMenu(sf::RenderTarget& window, const sf::Font& font);
 
 
 // Game functions
     void handleMenuClick(sf::Vector2i mousePos, GameState& state, GameState& previousState, bool& shouldClose);
 
-    void drawPauseScreen(sf::RenderWindow& window, const sf::Font& font);
+    void drawPauseScreen(sf::RenderTarget& window, const sf::Font& font);
 
-    void drawGameOverScreen(sf::RenderWindow& window, const sf::Font& font);
+    void drawGameOverScreen(sf::RenderTarget& window, const sf::Font& font, int outcome, int rankedGames);
 
-    void drawHowToPlay(sf::RenderWindow& window, const sf::Font& font);
+    void drawHowToPlay(sf::RenderTarget& window, const sf::Font& font);
     void handleHowToPlayClick(sf::Vector2i mousePos, GameState& state, GameState& previousState);
 
-    void drawBrightnessOverlay(sf::RenderWindow& window);
+    void drawBrightnessOverlay(sf::RenderTarget& window);
+
+    void drawLoadingScreen(sf::RenderTarget& window, float progress);
+    void drawAllocOverlay(sf::RenderTarget& window, const sf::Font& font,
+                          const AllocStats::Totals& counts, int frames, float frameMs);
+    void prewarmGlyphs(const sf::Font& font);
 
     void startLineClearAnim(int* clearedLines, int count);
     void updateLineClearAnim(float dt);
-    void drawLineClearAnim(sf::RenderWindow& window);
+    void drawLineClearAnim(sf::RenderTarget& window);
+
+    const int MAX_PARTICLES = 1024;
 
     struct Particle {
         float x, y;
@@ -78,9 +102,9 @@ namespace UI {
 
     void addParticles(float x, float y, sf::Color color, int count);
     void updateParticles(float dt);
-    void drawParticles(sf::RenderWindow& window);
+    void drawParticles(sf::RenderTarget& window);
 
-    void drawSoftDropTrail(sf::RenderWindow& window, const Piece* piece, int px, int py, bool isActive);
+    void drawSoftDropTrail(sf::RenderTarget& window, const Piece* piece, int px, int py, bool isActive);
 
-    void drawCombo(sf::RenderWindow& window, const sf::Font& font);
+    void drawCombo(sf::RenderTarget& window, const sf::Font& font);
 }
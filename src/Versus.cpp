@@ -0,0 +1,356 @@
+/*
+ * Tetris Game - Rollback netcode versus mode implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Versus.h"
+#include "Audio.h"
+#include "Net.h"
+#include "NetProtocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace Versus {
+
+    static const int HISTORY = 64;
+    static const float VERSUS_DELAY = 0.8f;
+    static const float HELLO_INTERVAL = 1.f;
+
+    struct MatchState {
+        GameSnapshot players[2];
+        std::uint8_t lastInput[2];
+    };
+
+    static Net::Socket sock = Net::INVALID_SOCKET_HANDLE;
+    static Net::Address relayAddress = {};
+    static HelloPacket hello = {};
+    static Phase currentPhase = Phase::OFF;
+    static int localIndex = 0;
+
+    static MatchState live;
+    static MatchState history[HISTORY];
+    static std::uint32_t checksums[HISTORY];
+    static std::uint8_t localInputs[HISTORY];
+    static std::uint8_t remoteInputs[HISTORY];
+    static std::uint8_t usedRemote[HISTORY];
+
+    static int currentTick = 0;
+    static int remoteConfirmed = 0;
+    static int localAcked = 0;
+    static int rollbackFrom = -1;
+    static long long pendingChecksumTick = -1;
+    static std::uint32_t pendingChecksum = 0;
+    static float accumulator = 0.f;
+    static float silence = 0.f;
+    static float helloTimer = 0.f;
+    static bool desync = false;
+    static int matchResult = 0;
+    static Stats matchStats = {};
+
+/** Turn a held-key bitmask change into onGameKey presses and releases */
+    static void applyInput(std::uint8_t previous, std::uint8_t current) {
+        for (int k = 0; k < static_cast<int>(GameKey::COUNT); k++) {
+            std::uint8_t bit = static_cast<std::uint8_t>(1 << k);
+            if ((previous ^ current) & bit) {
+                onGameKey(static_cast<GameKey>(k), (current & bit) != 0);
+            }
+        }
+    }
+
+/** Step both players through tick t; only a local first pass plays effects */
+    static void simulateTick(int t, bool firstPass) {
+        int slot = t % HISTORY;
+        history[slot] = live;
+
+        std::uint8_t remote = 0;
+        if (t < remoteConfirmed) {
+            remote = remoteInputs[slot];
+        } else if (remoteConfirmed > 0) {
+            remote = remoteInputs[(remoteConfirmed - 1) % HISTORY];
+        }
+        usedRemote[slot] = remote;
+
+        std::uint8_t inputs[2];
+        inputs[localIndex] = localInputs[slot];
+        inputs[1 - localIndex] = remote;
+
+        for (int p = 0; p < 2; p++) {
+            effectsEnabled = firstPass && p == localIndex;
+            restoreSnapshot(live.players[p]);
+            applyInput(live.lastInput[p], inputs[p]);
+            advanceGame(TICK);
+            saveSnapshot(live.players[p]);
+            live.lastInput[p] = inputs[p];
+        }
+        effectsEnabled = true;
+
+        for (int p = 0; p < 2; p++) {
+            GameSnapshot& from = live.players[p];
+            live.players[1 - p].pendingGarbage += from.garbageSent;
+            from.garbageSent = 0;
+        }
+
+        checksums[slot] = snapshotChecksum(live.players[0]) * 31u ^ snapshotChecksum(live.players[1]);
+    }
+
+/** Reset both slots from the shared seed and each player's handling */
+    static void startMatch(const StartPacket& start) {
+        localIndex = start.playerIndex & 1;
+        gameMode = GameMode::VERSUS;
+
+        // A predicted tick can top a player out and a rollback undo it, so
+        // nothing counts until finish() has the confirmed ending.
+        resultsEnabled = false;
+        effectsEnabled = false;
+        resetGame(start.seed);
+        DAS_DELAY = start.opponentDasDelay;
+        ARR_DELAY = start.opponentArrDelay;
+        instantSoftDrop = start.opponentInstantSoftDrop != 0;
+        baseDelay = gameDelay = VERSUS_DELAY;
+        saveSnapshot(live.players[1 - localIndex]);
+        effectsEnabled = true;
+
+        resetGame(start.seed);
+        DAS_DELAY = hello.dasDelay;
+        ARR_DELAY = hello.arrDelay;
+        instantSoftDrop = hello.instantSoftDrop != 0;
+        baseDelay = gameDelay = VERSUS_DELAY;
+        saveSnapshot(live.players[localIndex]);
+
+        live.lastInput[0] = live.lastInput[1] = 0;
+        currentTick = 0;
+        remoteConfirmed = 0;
+        localAcked = 0;
+        rollbackFrom = -1;
+        pendingChecksumTick = -1;
+        accumulator = 0.f;
+        silence = 0.f;
+        desync = false;
+        matchResult = 0;
+        matchStats = {};
+        currentPhase = Phase::PLAYING;
+        Audio::playStartGame();
+    }
+
+    static void sendHello() {
+        Net::sendTo(sock, relayAddress, &hello, sizeof(hello));
+        helloTimer = 0.f;
+    }
+
+/** Take in remote inputs, acks and checksums; note the oldest misprediction */
+    static void receiveInput(const InputPacket& packet) {
+        silence = 0.f;
+        for (int i = 0; i < packet.count && i < INPUT_REDUNDANCY; i++) {
+            int t = static_cast<int>(packet.firstTick) + i;
+            if (t < remoteConfirmed) continue;
+            if (t > remoteConfirmed) break;
+
+            int slot = t % HISTORY;
+            remoteInputs[slot] = packet.inputs[i];
+            if (t < currentTick && usedRemote[slot] != packet.inputs[i]) {
+                rollbackFrom = (rollbackFrom < 0) ? t : std::min(rollbackFrom, t);
+            }
+            remoteConfirmed++;
+        }
+
+        localAcked = std::max(localAcked, static_cast<int>(packet.ackTick));
+        if (packet.checksumTick != UINT32_MAX) {
+            pendingChecksumTick = packet.checksumTick;
+            pendingChecksum = packet.checksum;
+        }
+    }
+
+    static void receivePackets() {
+        unsigned char buffer[64];
+        Net::Address from;
+        int size;
+        while ((size = Net::receiveFrom(sock, from, buffer, sizeof(buffer))) > 0) {
+            if (!Net::sameAddress(from, relayAddress)) continue;
+
+            if (buffer[0] == NET_START && size == sizeof(StartPacket) && currentPhase == Phase::WAITING) {
+                StartPacket start;
+                std::memcpy(&start, buffer, sizeof(start));
+                startMatch(start);
+            } else if (buffer[0] == NET_INPUT && size == sizeof(InputPacket) && currentPhase != Phase::WAITING) {
+                InputPacket packet;
+                std::memcpy(&packet, buffer, sizeof(packet));
+                receiveInput(packet);
+            }
+        }
+    }
+
+/** Restore the snapshot before the oldest mispredicted tick and replay to now */
+    static void rollback() {
+        if (rollbackFrom < 0) return;
+
+        auto begin = std::chrono::steady_clock::now();
+        live = history[rollbackFrom % HISTORY];
+        for (int t = rollbackFrom; t < currentTick; t++) {
+            simulateTick(t, false);
+        }
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+        matchStats.rollbacks++;
+        matchStats.maxResimTicks = std::max(matchStats.maxResimTicks, currentTick - rollbackFrom);
+        matchStats.resimMicros += micros;
+        rollbackFrom = -1;
+    }
+
+/** Send unacknowledged local inputs plus our newest confirmed checksum */
+    static void sendInputs() {
+        InputPacket packet = {};
+        packet.type = NET_INPUT;
+        packet.firstTick = static_cast<std::uint32_t>(localAcked);
+        packet.count = static_cast<std::uint8_t>(std::min(currentTick - localAcked, INPUT_REDUNDANCY));
+        for (int i = 0; i < packet.count; i++) {
+            packet.inputs[i] = localInputs[(localAcked + i) % HISTORY];
+        }
+        packet.ackTick = static_cast<std::uint32_t>(remoteConfirmed);
+
+        int confirmed = std::min(currentTick, remoteConfirmed) - 1;
+        packet.checksumTick = (confirmed >= 0) ? static_cast<std::uint32_t>(confirmed) : UINT32_MAX;
+        packet.checksum = (confirmed >= 0) ? checksums[confirmed % HISTORY] : 0;
+        Net::sendTo(sock, relayAddress, &packet, sizeof(packet));
+    }
+
+/** Compare the peer's checksum once we have simulated that tick with confirmed inputs */
+    static void checkDesync() {
+        if (pendingChecksumTick < 0) return;
+        int t = static_cast<int>(pendingChecksumTick);
+        if (t >= currentTick || t >= remoteConfirmed) return;
+
+        if (currentTick - t <= HISTORY && checksums[t % HISTORY] != pendingChecksum && !desync) {
+            desync = true;
+            std::fprintf(stderr, "Versus: desync at tick %d (local %08x, remote %08x)\n",
+                         t, checksums[t % HISTORY], pendingChecksum);
+        }
+        pendingChecksumTick = -1;
+    }
+
+/** End the match and record the local game once, from confirmed state */
+    static void finish(int outcome) {
+        currentPhase = Phase::FINISHED;
+        matchResult = outcome;
+
+        restoreSnapshot(live.players[localIndex]);
+        resultsEnabled = true;
+        saveHighScore();
+        recordFinishedGame();
+        saveSnapshot(live.players[localIndex]);
+
+        std::printf("Versus: %d ticks, %d rollbacks, longest %d ticks, %.1f us per rollback\n",
+                    currentTick, matchStats.rollbacks, matchStats.maxResimTicks,
+                    matchStats.rollbacks ? matchStats.resimMicros / matchStats.rollbacks : 0.0);
+    }
+
+/** Open a socket to the relay and queue for a match */
+    bool connect(const std::string& relay) {
+        if (!Net::resolve(relay, RELAY_PORT, relayAddress)) {
+            std::fprintf(stderr, "Versus: cannot resolve relay %s\n", relay.c_str());
+            return false;
+        }
+        sock = Net::openUdp(0);
+        if (sock == Net::INVALID_SOCKET_HANDLE) {
+            std::fprintf(stderr, "Versus: cannot open UDP socket\n");
+            return false;
+        }
+
+        hello = {};
+        hello.type = NET_HELLO;
+        hello.instantSoftDrop = instantSoftDrop ? 1 : 0;
+        hello.dasDelay = DAS_DELAY;
+        hello.arrDelay = ARR_DELAY;
+        requeue();
+        return true;
+    }
+
+/** Ask the relay for a new opponent */
+    void requeue() {
+        if (sock == Net::INVALID_SOCKET_HANDLE) return;
+        currentPhase = Phase::WAITING;
+        sendHello();
+    }
+
+    void disconnect() {
+        Net::closeSocket(sock);
+        sock = Net::INVALID_SOCKET_HANDLE;
+        currentPhase = Phase::OFF;
+        resultsEnabled = true;
+        gameMode = GameMode::MARATHON;
+        DAS_DELAY = hello.dasDelay;
+        ARR_DELAY = hello.arrDelay;
+        instantSoftDrop = hello.instantSoftDrop != 0;
+    }
+
+/** Run networking, rollback and fixed ticks for one frame; returns ticks stepped */
+    int update(float dt, std::uint8_t localInput) {
+        if (currentPhase == Phase::OFF) return 0;
+
+        receivePackets();
+
+        if (currentPhase == Phase::WAITING) {
+            helloTimer += dt;
+            if (helloTimer >= HELLO_INTERVAL) sendHello();
+            return 0;
+        }
+
+        rollback();
+
+        int stepped = 0;
+        if (currentPhase == Phase::PLAYING) {
+            accumulator = std::min(accumulator + dt, TICK * MAX_ROLLBACK);
+            while (accumulator >= TICK) {
+                if (currentTick - remoteConfirmed >= MAX_ROLLBACK) break;
+                if (currentTick - localAcked >= HISTORY / 2) break;
+                if (live.players[0].isGameOver || live.players[1].isGameOver) break;
+
+                localInputs[currentTick % HISTORY] = localInput;
+                simulateTick(currentTick, true);
+                currentTick++;
+                accumulator -= TICK;
+                stepped++;
+            }
+
+            silence += dt;
+            bool localOver = live.players[localIndex].isGameOver;
+            bool remoteOver = live.players[1 - localIndex].isGameOver;
+            if ((localOver || remoteOver) && remoteConfirmed >= currentTick) {
+                finish(localOver == remoteOver ? 0 : (localOver ? -1 : 1));
+            } else if (silence >= DISCONNECT_TIMEOUT) {
+                std::fprintf(stderr, "Versus: opponent timed out\n");
+                finish(1);
+            }
+        }
+
+        sendInputs();
+        checkDesync();
+
+        restoreSnapshot(live.players[localIndex]);
+        if (currentPhase == Phase::FINISHED) isGameOver = true;
+        return stepped;
+    }
+
+    Phase phase() {
+        return currentPhase;
+    }
+
+/** 1 when the local player won, -1 when they lost, 0 for a draw or no result yet */
+    int result() {
+        return matchResult;
+    }
+
+    bool desynced() {
+        return desync;
+    }
+
+    const GameSnapshot& opponent() {
+        return live.players[1 - localIndex];
+    }
+
+    const Stats& stats() {
+        return matchStats;
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * Tetris Game - Rollback netcode versus mode
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Game.h"
+#include <cstdint>
+#include <string>
+
+// Two-player versus over UDP through a relay. Both players are simulated
+// on every client in fixed ticks by swapping GameSnapshots in and out of
+// the game globals. Remote inputs are predicted (last known input held);
+// when the real ones arrive and differ, the match is restored to the
+// snapshot before that tick and re-simulated to the present in the same
+// frame. Per-tick checksums from both sides are compared to spot desyncs.
+namespace Versus {
+    const float TICK = 1.f / TARGET_FPS;
+    const int MAX_ROLLBACK = 12;
+    const float DISCONNECT_TIMEOUT = 5.f;
+
+    enum class Phase {
+        OFF,
+        WAITING,
+        PLAYING,
+        FINISHED
+    };
+
+    struct Stats {
+        int rollbacks;
+        int maxResimTicks;
+        double resimMicros;
+    };
+
+    bool connect(const std::string& relay);
+    void requeue();
+    void disconnect();
+
+    int update(float dt, std::uint8_t localInput);
+
+    Phase phase();
+    int result();
+    bool desynced();
+    const GameSnapshot& opponent();
+    const Stats& stats();
+}
@@ -0,0 +1,100 @@
+/*
+ * Tetris Game - Zobrist position hashing implementation
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#include "Zobrist.h"
+#include "Game.h"
+
+namespace Zobrist {
+
+    static constexpr std::uint64_t splitmix(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+/** Fill every key from one fixed seed at compile time */
+    static constexpr Keys makeKeys() {
+        Keys k = {};
+        std::uint64_t state = 0x7E7415ull;
+        for (int i = 0; i < H; i++) {
+            for (int j = 0; j < W; j++) {
+                bool wall = i == H - 1 || j == 0 || j == W - 1;
+                std::uint64_t key = splitmix(state);
+                k.cell[i][j] = wall ? 0 : key;
+            }
+        }
+        for (int p = 0; p < 7; p++) k.active[p] = splitmix(state);
+        for (int p = 0; p < 7; p++) k.hold[p] = splitmix(state);
+        for (int s = 0; s < QUEUE_SLOTS; s++) {
+            for (int p = 0; p < 7; p++) k.queue[s][p] = splitmix(state);
+        }
+        for (int c = 0; c < COMBO_STATES; c++) k.combo[c] = splitmix(state);
+        k.backToBack = splitmix(state);
+        k.holdUsed = splitmix(state);
+        return k;
+    }
+
+    constexpr Keys keys = makeKeys();
+
+/** Hash of one row given as a column bitmask (bit j = column j) */
+    std::uint64_t rowKey(int row, std::uint16_t mask) {
+        std::uint64_t hash = 0;
+        while (mask) {
+            int col = __builtin_ctz(mask);
+            hash ^= keys.cell[row][col];
+            mask &= mask - 1;
+        }
+        return hash;
+    }
+
+    std::uint64_t hashRows(const char (&board)[H][W], int firstRow, int endRow) {
+        std::uint64_t hash = 0;
+        for (int i = firstRow; i < endRow; i++) {
+            for (int j = 1; j < W - 1; j++) {
+                if (board[i][j] != ' ') hash ^= keys.cell[i][j];
+            }
+        }
+        return hash;
+    }
+
+    std::uint64_t hashBoard(const char (&board)[H][W]) {
+        return hashRows(board, 0, H - 1);
+    }
+
+/** Everything but the board; piece types are getPieceIndex values, -1 for none */
+    std::uint64_t stateKey(int active, int hold, const int (&queue)[QUEUE_SLOTS],
+                           int comboCount, bool backToBack, bool canHold) {
+        std::uint64_t hash = 0;
+        if (active >= 0) hash ^= keys.active[active];
+        if (hold >= 0) hash ^= keys.hold[hold];
+        for (int s = 0; s < QUEUE_SLOTS; s++) {
+            if (queue[s] >= 0) hash ^= keys.queue[s][queue[s]];
+        }
+        int combo = comboCount < 0 ? 0 : comboCount < COMBO_STATES ? comboCount : COMBO_STATES - 1;
+        hash ^= keys.combo[combo];
+        if (backToBack) hash ^= keys.backToBack;
+        if (!canHold) hash ^= keys.holdUsed;
+        return hash;
+    }
+
+    static int typeOf(const Piece* piece) {
+        if (!piece) return -1;
+        for (int i = 0; i < 16; i++) {
+            char c = piece->shape[i / 4][i % 4];
+            if (c != ' ') return getPieceIndex(c);
+        }
+        return -1;
+    }
+
+/** Hash of the live position: incremental board hash plus piece and chain state */
+    std::uint64_t positionHash() {
+        int queue[QUEUE_SLOTS] = {typeOf(nextPiece)};
+        for (int i = 0; i < 4; i++) queue[i + 1] = typeOf(nextQueue[i]);
+        return boardHash ^ stateKey(typeOf(currentPiece), typeOf(holdPiece), queue,
+                                    comboCount, backToBackActive, canHold);
+    }
+}
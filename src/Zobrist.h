@@ -0,0 +1,43 @@
+/*
+ * Tetris Game - Zobrist position hashing
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ */
+
+#pragma once
+#include "Config.h"
+#include <cstdint>
+
+// A position hash is the XOR of one fixed random key per occupied playfield
+// cell (walls excluded) plus keys for the active piece type, hold, each
+// queue slot, back-to-back, combo and hold availability. The board part is
+// kept incrementally in boardHash (Game.h) by block2Board and removeLine,
+// so hashing a live position costs a handful of XORs. Keys come from a
+// fixed seed, so hashes match across runs, threads and processes.
+namespace Zobrist {
+    const int COMBO_STATES = 16;
+    const int QUEUE_SLOTS = 5;
+
+    struct Keys {
+        std::uint64_t cell[H][W];
+        std::uint64_t active[7];
+        std::uint64_t hold[7];
+        std::uint64_t queue[QUEUE_SLOTS][7];
+        std::uint64_t combo[COMBO_STATES];
+        std::uint64_t backToBack;
+        std::uint64_t holdUsed;
+    };
+
+    extern const Keys keys;
+
+    inline std::uint64_t cellKey(int row, int col) {
+        return keys.cell[row][col];
+    }
+
+    std::uint64_t rowKey(int row, std::uint16_t mask);
+    std::uint64_t hashRows(const char (&board)[H][W], int firstRow, int endRow);
+    std::uint64_t hashBoard(const char (&board)[H][W]);
+    std::uint64_t stateKey(int active, int hold, const int (&queue)[QUEUE_SLOTS],
+                           int comboCount, bool backToBack, bool canHold);
+    std::uint64_t positionHash();
+}
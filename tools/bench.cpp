@@ -0,0 +1,220 @@
+/*
+ * Tetris Game - Engine micro-benchmarks
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ *
+ * Usage: bench features [boards] [standard|guideline|wide]
+ *        bench jobs [games] [max threads]
+ *        bench allocs [pieces]
+ * features: times Features::extract over a fixed, seeded set of playable
+ * stacks (smooth surfaces, one well, occasional holes and T-slots) in 25
+ * timed rounds and prints the best, median and mean ns per board plus the
+ * average of every feature. The geometry picks the Board instantiation:
+ * the live 10x21 field, the guideline 10x40 field or the 16x24 wide field.
+ * jobs: plays the same seeded headless bot games through Jobs::parallelFor
+ * with 1, 2, ... N threads and prints games/s, speedup and efficiency.
+ * allocs: plays a scripted bot game one piece per frame after a warmup,
+ * doing a game tick's work with effects on (simulation, lock and clear
+ * particles, telemetry, sidebar text, frame publish), and fails if any
+ * frame in that steady state allocated on the heap.
+ */
+
+#include "../src/AllocStats.h"
+#include "../src/Bot.h"
+#include "../src/Features.h"
+#include "../src/Game.h"
+#include "../src/Jobs.h"
+#include "../src/Render.h"
+#include "../src/Telemetry.h"
+#include "../src/UI.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Features;
+
+/** A stack a reasonable player could have: bumpy surface, a well, few holes */
+template <typename Board>
+static Board makeStack(std::minstd_rand& rng) {
+    const int COLS = Board::COLS, ROWS = Board::ROWS;
+    Board rows = {};
+    int heights[COLS];
+    int height = 2 + static_cast<int>(rng() % 8);
+    int well = static_cast<int>(rng() % COLS);
+    for (int c = 0; c < COLS; c++) {
+        height += static_cast<int>(rng() % 3) - 1;
+        height = std::max(1, std::min(ROWS - 4, height));
+        heights[c] = c == well ? std::max(0, height - 4) : height;
+    }
+    for (int c = 0; c < COLS; c++) {
+        for (int k = 0; k < heights[c]; k++) rows.bits[ROWS - 1 - k] |= typename Board::Word(1) << c;
+    }
+    if (rng() % 4 == 0) {
+        int c = static_cast<int>(rng() % COLS);
+        if (heights[c] > 2) rows.bits[ROWS - 1 - static_cast<int>(rng() % (heights[c] - 1))] &= ~(typename Board::Word(1) << c);
+    }
+    return rows;
+}
+
+template <typename Board>
+static int benchFeatures(int boards, const char* geometry) {
+    std::minstd_rand rng(12345);
+    std::vector<Board> stacks(boards);
+    for (Board& rows : stacks) rows = makeStack<Board>(rng);
+
+    // The passes are timed in rounds: a shared host's speed can swing
+    // more than twofold within a second, which the mean absorbs and the
+    // best round does not.
+    const int rounds = 25;
+    const int passes = std::max(1, 20000000 / (boards * rounds));
+    double totals[FEATURE_COUNT] = {};
+    double roundNs[rounds];
+    long long sink = 0;
+
+    for (int round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; pass++) {
+            for (const Board& rows : stacks) {
+                Vector features = extract(rows);
+                sink += features.values[HOLES] + features.values[WELL_SUMS];
+            }
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        roundNs[round] = elapsed * 1e9 / (static_cast<double>(boards) * passes);
+    }
+    double meanNs = 0.0;
+    for (double ns : roundNs) meanNs += ns / rounds;
+    std::sort(roundNs, roundNs + rounds);
+
+    for (const Board& rows : stacks) {
+        Vector features = extract(rows);
+        for (int f = 0; f < FEATURE_COUNT; f++) totals[f] += features.values[f];
+    }
+
+    std::printf("features: %s %dx%d, %d boards x %d passes x %d rounds, best %.1f, median %.1f, mean %.1f ns/board (checksum %lld)\n",
+                geometry, Board::COLS, Board::ROWS, boards, passes, rounds, roundNs[0], roundNs[rounds / 2], meanNs, sink);
+    for (int f = 0; f < FEATURE_COUNT; f++) {
+        std::printf("  %-16s avg %6.2f\n", name(f), totals[f] / boards);
+    }
+    return 0;
+}
+
+static int benchJobs(int games, unsigned maxThreads) {
+    const int PIECES = 300;
+    effectsEnabled = false;
+    gameMode = GameMode::MARATHON;
+    Bot::init();
+    Bot::Weights weights = Bot::defaultWeights();
+
+    std::printf("jobs: %d games of %d pieces per run\n", games, PIECES);
+    std::printf("%8s %10s %8s %10s %12s\n", "threads", "games/s", "speedup", "efficiency", "checksum");
+    double baseline = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; threads++) {
+        if (threads > 1) Jobs::start(threads - 1);
+        std::vector<long long> scores(games);
+        auto start = std::chrono::steady_clock::now();
+        Jobs::parallelFor(0, games, 1, [&](int i) {
+            scores[i] = Bot::playGame(weights, static_cast<unsigned>(i + 1), PIECES, false).score;
+        });
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        Jobs::stop();
+
+        long long checksum = 0;
+        for (long long score : scores) checksum += score;
+        double rate = games / elapsed;
+        if (threads == 1) baseline = rate;
+        std::printf("%8u %10.1f %7.2fx %9.0f%% %12lld\n", threads, rate, rate / baseline,
+                    100.0 * rate / (baseline * threads), checksum);
+        std::fflush(stdout);
+    }
+    return 0;
+}
+
+static int benchAllocs(int pieces) {
+    const int WARMUP = 64;
+    // Past RESERVED_PIECES the telemetry columns would have to grow.
+    pieces = std::min(pieces, Telemetry::RESERVED_PIECES - WARMUP);
+    effectsEnabled = true;
+    resultsEnabled = true;
+    gameMode = GameMode::MARATHON;
+    Bot::init();
+    Bot::Weights weights = Bot::defaultWeights();
+    AllocStats::Scope scope(AllocStats::Subsystem::SIM);
+    SidebarText sidebar;
+
+    // One frame of the game loop: a piece played through the keyboard
+    // path with its particles, sounds and telemetry row, the render
+    // thread's particle step and sidebar text, and the render frame
+    // filled and published. Audio is never initialised here, so sounds
+    // return straight away.
+    auto frame = [&](int index) {
+        Bot::playPiece(weights, false);
+        for (int i = 0; i < 4; i++) UI::addParticles(STATS_W + x * TILE_SIZE, y * TILE_SIZE, sf::Color::White, 3);
+        UI::updateParticles(1.f / TARGET_FPS);
+        UI::formatSidebar(sidebar, gScore, gLevel, gLines);
+        Render::Frame& next = Render::frame();
+        saveSnapshot(next.game);
+        saveSettingsSnapshot(next.settings);
+        Render::publish(index);
+    };
+
+    resetGame(1);
+    for (int i = 0; i < WARMUP && !isGameOver; i++) frame(i);
+
+    AllocStats::setEnabled(true);
+    int frames = 0, dirty = 0;
+    std::uint64_t worst = 0;
+    AllocStats::Counts total = {0, 0};
+    while (frames < pieces && !isGameOver) {
+        AllocStats::Totals before = AllocStats::totals();
+        frame(WARMUP + frames);
+        AllocStats::Counts used = AllocStats::sum(AllocStats::difference(AllocStats::totals(), before));
+        frames++;
+        total.calls += used.calls;
+        total.bytes += used.bytes;
+        worst = std::max(worst, used.calls);
+        if (used.calls > 0) dirty++;
+    }
+    AllocStats::setEnabled(false);
+
+    std::printf("allocs: %d frames after %d warmup, %llu allocations (%llu bytes), worst frame %llu, %d frames allocated\n",
+                frames, WARMUP, static_cast<unsigned long long>(total.calls),
+                static_cast<unsigned long long>(total.bytes), static_cast<unsigned long long>(worst), dirty);
+    if (isGameOver) {
+        std::printf("FAIL: the bot topped out before %d frames\n", pieces);
+        return 1;
+    }
+    if (dirty > 0) {
+        std::printf("FAIL: steady-state frames must not allocate\n");
+        return 1;
+    }
+    std::printf("OK: zero allocations per frame\n");
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "features") {
+        int boards = std::max(1, argc > 2 ? std::atoi(argv[2]) : 4096);
+        std::string geometry = argc > 3 ? argv[3] : "standard";
+        if (geometry == "standard") return benchFeatures<StandardBoard>(boards, "standard");
+        if (geometry == "guideline") return benchFeatures<GuidelineBoard>(boards, "guideline");
+        if (geometry == "wide") return benchFeatures<WideBoard>(boards, "wide");
+    }
+    if (mode == "jobs") {
+        int games = argc > 2 ? std::atoi(argv[2]) : 256;
+        int threads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+        return benchJobs(std::max(1, games), static_cast<unsigned>(std::max(1, threads)));
+    }
+    if (mode == "allocs") {
+        int pieces = argc > 2 ? std::atoi(argv[2]) : 1000;
+        return benchAllocs(std::max(1, pieces));
+    }
+    std::fprintf(stderr, "usage: %s features [boards] [standard|guideline|wide] | jobs [games] [max threads] | allocs [pieces]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,97 @@
+/*
+ * Tetris Game - Training corpus recorder
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ *
+ * Usage: corpus [--out dir]
+ * Records the replays the profile-guided build trains on (Tetris --train).
+ * Each entry of GAMES is a bot game played through onGameKey and
+ * advanceGame in SIM_TICK_MS ticks, with keys paced like a player's, so
+ * pieces glide, lock through the lock delay and clear lines with their
+ * particle bursts. After its pieces the bot stops aiming and drops in
+ * place until the stack tops out, so every replay ends on the game-over
+ * screen. The output only depends on the rules: the same tree always
+ * writes the same files.
+ */
+
+#include "../src/Bot.h"
+#include "../src/Game.h"
+#include "../src/Persist.h"
+#include "../src/Replay.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+struct CorpusGame {
+    const char* name;
+    Difficulty difficulty;
+    unsigned seed;
+    int pieces;
+    float keyTime;
+    bool instantSoftDrop;
+};
+
+// Slow to fast: a long easy marathon, a normal one, and a hard one with
+// quick hands and instant soft drop, which reaches the higher levels.
+static const CorpusGame GAMES[] = {
+    {"01-marathon-easy", Difficulty::EASY, 11, 150, 0.06f, false},
+    {"02-marathon-normal", Difficulty::NORMAL, 22, 200, 0.04f, false},
+    {"03-marathon-hard", Difficulty::HARD, 33, 250, 0.025f, true},
+};
+
+/** Hard-drop every piece where it spawns until the game ends */
+static void topOut(float keyTime) {
+    const float tick = SIM_TICK_MS / 1000.f;
+    while (!isGameOver) {
+        onGameKey(GameKey::HARD_DROP, true);
+        onGameKey(GameKey::HARD_DROP, false);
+        for (float t = 0.f; t < keyTime || (onGround && !isGameOver); t += tick) advanceGame(tick);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string out = "pgo/corpus";
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--out" && i + 1 < argc) {
+            out = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--out dir]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Headless: no particles, sounds, telemetry or saved scores.
+    effectsEnabled = false;
+    gameMode = GameMode::MARATHON;
+    Bot::init();
+    Bot::Weights weights = Bot::defaultWeights();
+    std::error_code ec;
+    std::filesystem::create_directories(out, ec);
+
+    for (const CorpusGame& game : GAMES) {
+        difficulty = game.difficulty;
+        instantSoftDrop = game.instantSoftDrop;
+        resetGame(game.seed);
+        Replay::begin();
+        while (!isGameOver && totalPieces < game.pieces) Bot::playPiece(weights, false, game.keyTime);
+        int aimed = totalPieces, lines = gLines;
+        topOut(game.keyTime);
+
+        Replay::Recording recording;
+        Replay::end(recording);
+        std::string path = out + "/" + game.name + ".rpl";
+        std::string bytes = Replay::serialize(recording);
+        if (!Persist::writeAtomic(path, bytes)) {
+            std::fprintf(stderr, "corpus: could not write %s\n", path.c_str());
+            return 1;
+        }
+        if (!Replay::run(recording)) {
+            std::fprintf(stderr, "corpus: %s does not replay to the recorded game\n", path.c_str());
+            return 1;
+        }
+        std::printf("%s: %d pieces aimed, %d lines, score %d, %.1f s of play, %lld ticks, %zu bytes\n",
+                    path.c_str(), aimed, lines, gScore, playTime, Replay::ticks(recording), bytes.size());
+    }
+    return 0;
+}
@@ -0,0 +1,822 @@
+/*
+ * Tetris Game - Differential rules fuzzer
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ *
+ * Usage: fuzz [--runs N] [--ticks N] [--seed N] [--threads N] [--plant]
+ * Drives seeded random input streams through two rules engines in
+ * lockstep and compares their full rules state after every tick. The
+ * reference is the game itself: the char-grid canMove, Piece::rotate,
+ * removeLine and applyLineClearScore in Game.cpp, reached through the
+ * same calls onGameKey and advanceGame make. The candidate is a bitboard
+ * engine on StandardBoard written from the rules, not from Game.cpp; a
+ * faster rewrite plugs in as another class with reset/apply/read. On the
+ * first mismatch the input stream is shrunk to a minimal one that still
+ * diverges and printed with both states. --plant swaps two of the
+ * candidate's wall kicks to check that the harness catches and shrinks
+ * a real divergence.
+ */
+
+#include "../src/Board.h"
+#include "../src/Features.h"
+#include "../src/Game.h"
+#include "../src/Jobs.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Rows = StandardBoard;
+
+// One input per tick: a key press or a rules event from the game loop.
+enum Op : std::uint8_t {
+    LEFT,
+    RIGHT,
+    ROTATE,
+    SOFT_DROP,
+    GRAVITY,
+    HARD_DROP,
+    HOLD,
+    GARBAGE,
+    OP_COUNT
+};
+
+static const char* opNames[OP_COUNT] = {"left", "right", "rotate", "soft", "gravity", "drop", "hold", "garbage"};
+
+// Everything the rules decide, in a form both engines can produce. Cell
+// letters are cosmetic and left out; pieces are compared by type and the
+// row masks of their current shape.
+struct RulesState {
+    Rows rows;
+    std::int8_t current, hold;
+    std::int8_t queue[5];
+    std::uint8_t shape[4], holdShape[4];
+    int x, y;
+    int score, lines, level, combo, lastClearLines;
+    int tSpins, tetrises, pieces;
+    int pieceCount[7];
+    float gameDelay;
+    bool backToBack, canHold, gameOver, lastMoveWasRotate;
+};
+
+static const char* firstDifference(const RulesState& a, const RulesState& b) {
+    if (std::memcmp(a.rows.bits, b.rows.bits, sizeof(a.rows.bits)) != 0) return "board";
+    if (a.current != b.current || std::memcmp(a.shape, b.shape, sizeof(a.shape)) != 0) return "current piece";
+    if (a.hold != b.hold || std::memcmp(a.holdShape, b.holdShape, sizeof(a.holdShape)) != 0) return "hold piece";
+    if (std::memcmp(a.queue, b.queue, sizeof(a.queue)) != 0) return "queue";
+    if (a.x != b.x || a.y != b.y) return "position";
+    if (a.score != b.score) return "score";
+    if (a.lines != b.lines || a.lastClearLines != b.lastClearLines) return "lines";
+    if (a.level != b.level || a.gameDelay != b.gameDelay) return "level";
+    if (a.combo != b.combo) return "combo";
+    if (a.backToBack != b.backToBack) return "back-to-back";
+    if (a.tSpins != b.tSpins || a.tetrises != b.tetrises) return "clear counters";
+    if (a.pieces != b.pieces || std::memcmp(a.pieceCount, b.pieceCount, sizeof(a.pieceCount)) != 0) return "piece counts";
+    if (a.canHold != b.canHold) return "can hold";
+    if (a.lastMoveWasRotate != b.lastMoveWasRotate) return "last move";
+    if (a.gameOver != b.gameOver) return "game over";
+    return nullptr;
+}
+
+/** Type index and row masks of a piece object, -1 and empty for none */
+static std::int8_t describe(const Piece* piece, std::uint8_t (&rows)[4]) {
+    std::int8_t type = -1;
+    for (int i = 0; i < 4; i++) {
+        rows[i] = 0;
+        if (!piece) continue;
+        for (int j = 0; j < 4; j++) {
+            if (piece->shape[i][j] == ' ') continue;
+            rows[i] |= 1u << j;
+            if (type < 0) type = static_cast<std::int8_t>(getPieceIndex(piece->shape[i][j]));
+        }
+    }
+    return type;
+}
+
+// The game's own rules on the calling thread's thread_local state. The
+// grid and pieces are converted to masks only after an op that can change
+// them (rotate, lock, hold, garbage); plain moves leave the cache valid.
+struct ReferenceEngine {
+    void reset(unsigned seed) {
+        resetGame(seed);
+        stale_ = true;
+    }
+
+    void apply(Op op) {
+        if (isGameOver) return;
+        stale_ |= op == ROTATE || op == HARD_DROP || op == HOLD || op == GARBAGE;
+        switch (op) {
+            case LEFT:
+                if (canMove(-1, 0)) x--;
+                lastMoveWasRotate = false;
+                break;
+            case RIGHT:
+                if (canMove(1, 0)) x++;
+                lastMoveWasRotate = false;
+                break;
+            case ROTATE:
+                currentPiece->rotate(x, y);
+                lastMoveWasRotate = true;
+                break;
+            case SOFT_DROP:
+                if (canMove(0, 1)) {
+                    y++;
+                    gScore += 1;
+                }
+                lastMoveWasRotate = false;
+                break;
+            case GRAVITY:
+                if (canMove(0, 1)) {
+                    y++;
+                } else {
+                    lockPiece();
+                    stale_ = true;
+                }
+                break;
+            case HARD_DROP: {
+                int ghostY = getGhostY();
+                gScore += (ghostY - y) * 2;
+                y = ghostY;
+                lockPiece();
+                break;
+            }
+            case HOLD:
+                swapHold();
+                break;
+            default:
+                addGarbageRows(1);
+                break;
+        }
+    }
+
+    void read(RulesState& s) {
+        if (stale_) {
+            pieces_.rows = Features::fromBoard(board);
+            pieces_.current = describe(currentPiece, pieces_.shape);
+            pieces_.hold = describe(holdPiece, pieces_.holdShape);
+            std::uint8_t scratch[4];
+            pieces_.queue[0] = describe(nextPiece, scratch);
+            for (int i = 0; i < 4; i++) pieces_.queue[i + 1] = describe(nextQueue[i], scratch);
+            stale_ = false;
+        }
+        s.rows = pieces_.rows;
+        s.current = pieces_.current;
+        s.hold = pieces_.hold;
+        std::memcpy(s.shape, pieces_.shape, sizeof(s.shape));
+        std::memcpy(s.holdShape, pieces_.holdShape, sizeof(s.holdShape));
+        std::memcpy(s.queue, pieces_.queue, sizeof(s.queue));
+        s.x = x;
+        s.y = y;
+        s.score = gScore;
+        s.lines = gLines;
+        s.level = gLevel;
+        s.combo = comboCount;
+        s.lastClearLines = lastClearLines;
+        s.tSpins = tSpinCount;
+        s.tetrises = tetrisCount;
+        s.pieces = totalPieces;
+        std::memcpy(s.pieceCount, pieceCount, sizeof(s.pieceCount));
+        s.gameDelay = gameDelay;
+        s.backToBack = backToBackActive;
+        s.canHold = canHold;
+        s.gameOver = isGameOver;
+        s.lastMoveWasRotate = lastMoveWasRotate;
+    }
+
+private:
+    RulesState pieces_;
+    bool stale_ = true;
+};
+
+// The same rules on a bitboard: pieces are a type and an orientation
+// into precomputed row masks, collisions are Board::fits, clears are
+// Board::clearFullRows. Coordinates follow the game's: x and y are the
+// top-left of the 4x4 box on the walled board, interior column = x - 1.
+class BitboardEngine {
+public:
+    static const int SPAWN_X = 4;
+    static const int T_TYPE = 2;
+
+    explicit BitboardEngine(bool planted = false) : planted_(planted) {}
+
+    /** Build every orientation from the spawn shapes: T by its own table, O not at all */
+    static void init() {
+        static const std::uint8_t spawn[7][4] = {
+            {0x0, 0xF, 0x0, 0x0}, {0x0, 0x6, 0x6, 0x0}, {0x2, 0x7, 0x0, 0x0}, {0x6, 0x3, 0x0, 0x0},
+            {0x3, 0x6, 0x0, 0x0}, {0x1, 0x7, 0x0, 0x0}, {0x4, 0x7, 0x0, 0x0},
+        };
+        static const std::uint8_t tStates[4][4] = {
+            {0x2, 0x7, 0x0, 0x0}, {0x2, 0x6, 0x2, 0x0}, {0x0, 0x7, 0x2, 0x0}, {0x2, 0x3, 0x2, 0x0},
+        };
+        for (int type = 0; type < 7; type++) {
+            for (int r = 0; r < 4; r++) {
+                if (type == T_TYPE) {
+                    std::memcpy(shapes_[type][r], tStates[r], 4);
+                } else if (r == 0) {
+                    std::memcpy(shapes_[type][r], spawn[type], 4);
+                } else {
+                    // Clockwise in the 4x4 box: cell (i, j) moves to (j, 3 - i).
+                    const std::uint8_t* from = shapes_[type][r - 1];
+                    std::uint8_t* to = shapes_[type][r];
+                    for (int i = 0; i < 4; i++) to[i] = 0;
+                    for (int i = 0; i < 4; i++) {
+                        for (int j = 0; j < 4; j++) {
+                            if (from[i] >> j & 1) to[j] |= 1u << (3 - i);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void reset(unsigned seed) {
+        std::memset(&rows_, 0, sizeof(rows_));
+        bagRng_.seed(seed);
+        garbageRng_.seed(seed ^ 0x9E3779B9u);
+        for (int i = 0; i < 7; i++) bag_[i] = i;
+        bagIndex_ = 7;
+        current_ = drawFromBag();
+        for (int& slot : queue_) slot = drawFromBag();
+        orientation_ = 0;
+        hold_ = -1;
+        holdOrientation_ = 0;
+        x_ = SPAWN_X;
+        y_ = 0;
+        score_ = lines_ = level_ = currentLevel_ = combo_ = lastClearLines_ = 0;
+        tSpins_ = tetrises_ = pieces_ = 0;
+        std::memset(pieceCount_, 0, sizeof(pieceCount_));
+        gameDelay_ = getBaseDelayForDifficulty();
+        backToBack_ = false;
+        canHold_ = true;
+        gameOver_ = false;
+        lastRotate_ = false;
+    }
+
+    void apply(Op op) {
+        if (gameOver_) return;
+        switch (op) {
+            case LEFT:
+                if (fits(x_ - 1, y_)) x_--;
+                lastRotate_ = false;
+                break;
+            case RIGHT:
+                if (fits(x_ + 1, y_)) x_++;
+                lastRotate_ = false;
+                break;
+            case ROTATE:
+                rotate();
+                lastRotate_ = true;
+                break;
+            case SOFT_DROP:
+                if (fits(x_, y_ + 1)) {
+                    y_++;
+                    score_ += 1;
+                }
+                lastRotate_ = false;
+                break;
+            case GRAVITY:
+                if (fits(x_, y_ + 1)) y_++;
+                else lock();
+                break;
+            case HARD_DROP: {
+                int ghostY = ghost();
+                score_ += (ghostY - y_) * 2;
+                y_ = ghostY;
+                lock();
+                break;
+            }
+            case HOLD:
+                hold();
+                break;
+            default:
+                addGarbageRow();
+                break;
+        }
+    }
+
+    void read(RulesState& s) const {
+        s.rows = rows_;
+        s.current = static_cast<std::int8_t>(current_);
+        std::memcpy(s.shape, shape(), 4);
+        s.hold = static_cast<std::int8_t>(hold_);
+        if (hold_ >= 0) std::memcpy(s.holdShape, shapes_[hold_][holdOrientation_], 4);
+        else std::memset(s.holdShape, 0, 4);
+        for (int i = 0; i < 5; i++) s.queue[i] = static_cast<std::int8_t>(queue_[i]);
+        s.x = x_;
+        s.y = y_;
+        s.score = score_;
+        s.lines = lines_;
+        s.level = level_;
+        s.combo = combo_;
+        s.lastClearLines = lastClearLines_;
+        s.tSpins = tSpins_;
+        s.tetrises = tetrises_;
+        s.pieces = pieces_;
+        std::memcpy(s.pieceCount, pieceCount_, sizeof(s.pieceCount));
+        s.gameDelay = gameDelay_;
+        s.backToBack = backToBack_;
+        s.canHold = canHold_;
+        s.gameOver = gameOver_;
+        s.lastMoveWasRotate = lastRotate_;
+    }
+
+private:
+    static std::uint8_t shapes_[7][4][4];
+
+    Rows rows_;
+    std::minstd_rand bagRng_, garbageRng_;
+    int bag_[7];
+    int bagIndex_;
+    int current_, orientation_;
+    int hold_, holdOrientation_;
+    int queue_[5];
+    int x_, y_;
+    int score_, lines_, level_, currentLevel_, combo_, lastClearLines_;
+    int tSpins_, tetrises_, pieces_;
+    int pieceCount_[7];
+    float gameDelay_;
+    bool backToBack_, canHold_, gameOver_, lastRotate_;
+    bool planted_;
+
+    const std::uint8_t (&shape() const)[4] {
+        return shapes_[current_][orientation_];
+    }
+
+    bool fits(int boxX, int boxY) const {
+        return rows_.fits(shape(), boxX - 1, boxY);
+    }
+
+    int drawFromBag() {
+        if (bagIndex_ >= 7) {
+            for (int i = 6; i > 0; i--) std::swap(bag_[i], bag_[bagRng_() % (i + 1)]);
+            bagIndex_ = 0;
+        }
+        return bag_[bagIndex_++];
+    }
+
+    /** Filled cell on the walled board; walls and floor count, above the top does not */
+    bool filled(int row, int col) const {
+        if (col <= 0 || col >= W - 1 || row >= H - 1) return true;
+        return rows_.bits[row] >> (col - 1) & 1;
+    }
+
+    void rotate() {
+        if (current_ == 1) return;
+        static const int kicks[] = {0, -1, 1, -2, 2};
+        static const int plantedKicks[] = {0, 1, -1, -2, 2};
+        int next = (orientation_ + 1) % 4;
+        const int* order = planted_ ? plantedKicks : kicks;
+        for (int k = 0; k < 5; k++) {
+            int kick = order[k];
+            if (rows_.fits(shapes_[current_][next], x_ + kick - 1, y_)) {
+                orientation_ = next;
+                x_ += kick;
+                return;
+            }
+        }
+    }
+
+    /** Landing row by the game's definition: each column's lowest cell falls to the first filled cell */
+    int ghost() const {
+        const std::uint8_t* rows = shape();
+        int drop = H;
+        for (int j = 0; j < 4; j++) {
+            int bottom = -1;
+            for (int i = 3; i >= 0 && bottom < 0; i--) {
+                if (rows[i] >> j & 1) bottom = i;
+            }
+            if (bottom < 0) continue;
+            int dist = 0;
+            while (!filled(y_ + bottom + dist + 1, x_ + j)) dist++;
+            drop = std::min(drop, dist);
+        }
+        return y_ + (drop == H ? 0 : drop);
+    }
+
+    bool tSpin() const {
+        if (current_ != T_TYPE || !lastRotate_) return false;
+        // Every T orientation has its hub at (1, 1) of the box.
+        int row = y_ + 1, col = x_ + 1;
+        int corners = 0;
+        if (row > 0 && filled(row - 1, col - 1)) corners++;
+        if (row > 0 && filled(row - 1, col + 1)) corners++;
+        if (row < H - 1 && filled(row + 1, col - 1)) corners++;
+        if (row < H - 1 && filled(row + 1, col + 1)) corners++;
+        return corners >= 3;
+    }
+
+    bool perfectClear() const {
+        for (int r = 1; r < Rows::ROWS; r++) {
+            if (rows_.bits[r]) return false;
+        }
+        return true;
+    }
+
+    void score(int cleared) {
+        if (cleared <= 0) {
+            combo_ = 0;
+            if (!tSpin()) backToBack_ = false;
+            return;
+        }
+        lines_ += cleared;
+        lastClearLines_ = cleared;
+        bool spin = tSpin();
+        if (spin) tSpins_++;
+
+        float comboMultiplier = 1.0f + (combo_ * 0.5f);
+        int base;
+        if (spin) {
+            base = cleared == 2 ? 1200 : cleared == 3 ? 1600 : 800;
+        } else {
+            base = cleared == 2 ? 300 : cleared == 3 ? 500 : cleared == 4 ? 800 : 100 * cleared;
+            if (cleared == 4) tetrises_++;
+        }
+        bool special = cleared == 4 || spin;
+        float b2bMultiplier = special && backToBack_ ? 1.5f : 1.0f;
+        backToBack_ = special;
+        if (perfectClear()) base += 3000;
+        score_ += static_cast<int>(base * comboMultiplier * b2bMultiplier);
+        combo_++;
+
+        level_ = lines_ / 10;
+        if (level_ > currentLevel_) {
+            if (gameDelay_ > 0.1f) gameDelay_ -= 0.08f;
+            currentLevel_ = level_;
+        }
+    }
+
+    void lock() {
+        const std::uint8_t* rows = shape();
+        for (int i = 0; i < 4; i++) {
+            Rows::Row mask;
+            if (rows[i] && Rows::placeRow(rows[i], x_ - 1, mask)) rows_.bits[y_ + i] |= mask;
+        }
+        pieces_++;
+        pieceCount_[current_]++;
+        score(rows_.clearFullRows());
+
+        current_ = queue_[0];
+        for (int i = 0; i < 4; i++) queue_[i] = queue_[i + 1];
+        queue_[4] = drawFromBag();
+        orientation_ = 0;
+        x_ = SPAWN_X;
+        y_ = 0;
+        canHold_ = true;
+        if (gameOver_ || !fits(x_, y_)) gameOver_ = true;
+    }
+
+    void hold() {
+        if (!canHold_) return;
+        if (hold_ < 0) {
+            hold_ = current_;
+            holdOrientation_ = orientation_;
+            current_ = queue_[0];
+            orientation_ = 0;
+            for (int i = 0; i < 4; i++) queue_[i] = queue_[i + 1];
+            queue_[4] = drawFromBag();
+        } else {
+            std::swap(hold_, current_);
+            std::swap(holdOrientation_, orientation_);
+        }
+        x_ = SPAWN_X;
+        y_ = 0;
+        canHold_ = false;
+    }
+
+    void addGarbageRow() {
+        if (rows_.bits[0]) gameOver_ = true;
+        for (int r = 0; r + 1 < Rows::ROWS; r++) rows_.bits[r] = rows_.bits[r + 1];
+        int hole = static_cast<int>(garbageRng_() % Rows::COLS);
+        rows_.bits[Rows::ROWS - 1] = static_cast<Rows::Row>(Rows::FULL_ROW & ~(1u << hole));
+    }
+};
+
+std::uint8_t BitboardEngine::shapes_[7][4][4];
+
+// Where two engines first disagreed: the tick index into the stream
+// (-1 right after reset) and the first differing part of the state.
+struct Failure {
+    int tick;
+    const char* field;
+};
+
+struct RunStats {
+    long long ticks, locks, lines, tSpins, games;
+};
+
+// Writes a stream one piece at a time from the reference state, like a
+// careless player: take the lowest landing spot over every turn and
+// column (sometimes a random one), slide there with noise around the
+// moves, then hard drop or fall and wiggle near the floor, where kicks
+// into slots and T-spins happen. Aiming only makes rows fill and clear
+// often; whether the moves succeed is up to the engines. The ops are
+// recorded, so shrinking and reports replay them without the writer.
+class StreamWriter {
+public:
+    explicit StreamWriter(unsigned seed) : rng_(seed * 2654435761u + 1) {}
+
+    void nextPiece(const RulesState& state, std::vector<Op>& ops) {
+        int turns = 0, column = state.x - 1, landing = state.y;
+        aim(state, turns, column, landing);
+        if (rng_() % 8 == 0) {
+            turns = static_cast<int>(rng_() % 4);
+            column = static_cast<int>(rng_() % Rows::COLS) - 1;
+            landing = Rows::ROWS - 2;
+        }
+        int shift = column - (state.x - 1);
+        ops.insert(ops.end(), turns, ROTATE);
+        ops.insert(ops.end(), shift < 0 ? -shift : shift, shift < 0 ? LEFT : RIGHT);
+        noise(ops, static_cast<int>(rng_() % 2));
+        if (rng_() % 3 == 0) {
+            ops.push_back(HARD_DROP);
+            return;
+        }
+        // Fall to just above the landing row; exactly enough gravity to
+        // lock, so the rest does not drop the next piece unaimed.
+        ops.insert(ops.end(), std::max(0, landing - state.y - 1), GRAVITY);
+        noise(ops, static_cast<int>(rng_() % 3));
+        ops.insert(ops.end(), 2, GRAVITY);
+    }
+
+private:
+    // Noise between aimed moves: mostly moves and turns, with the
+    // occasional soft drop, hold or garbage row.
+    static constexpr Op NOISE[16] = {
+        LEFT, LEFT, LEFT, RIGHT, RIGHT, RIGHT, ROTATE, ROTATE, ROTATE, ROTATE,
+        SOFT_DROP, SOFT_DROP, GRAVITY, GRAVITY, HOLD, GARBAGE,
+    };
+
+    std::minstd_rand rng_;
+
+    void noise(std::vector<Op>& ops, int count) {
+        for (int i = 0; i < count; i++) ops.push_back(NOISE[rng_() & 15]);
+    }
+
+    /** Turns and box column that land lowest without covering empty cells; ties broken at random */
+    void aim(const RulesState& state, int& bestTurns, int& bestColumn, int& bestRow) {
+        std::uint8_t shape[4];
+        std::memcpy(shape, state.shape, sizeof(shape));
+        int bestScore = INT_MIN, ties = 0;
+        int tops[Rows::COLS];
+        state.rows.columnTops(tops);
+        for (int turns = 0; turns < 4; turns++) {
+            int bottom[4] = {-1, -1, -1, -1};
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 4; j++) {
+                    if (shape[i] >> j & 1) bottom[j] = i;
+                }
+            }
+            for (int column = -3; column < Rows::COLS; column++) {
+                if (!state.rows.fits(shape, column, state.y)) continue;
+                // Above the surface the landing row comes from the column
+                // tops; under an overhang, step down.
+                int row = Rows::ROWS;
+                for (int j = 0; j < 4; j++) {
+                    if (bottom[j] >= 0) row = std::min(row, tops[column + j] - bottom[j] - 1);
+                }
+                if (row < state.y) {
+                    row = state.y;
+                    while (state.rows.fits(shape, column, row + 1)) row++;
+                }
+                int score = 0;
+                for (int i = 0; i < 4; i++) {
+                    for (int j = 0; j < 4; j++) {
+                        if (!(shape[i] >> j & 1)) continue;
+                        score += row + i;
+                        int below = row + i + 1;
+                        bool covered = i < 3 && (shape[i + 1] >> j & 1);
+                        if (!covered && below < Rows::ROWS && !(state.rows.bits[below] >> (column + j) & 1)) score -= 16;
+                    }
+                }
+                if (score > bestScore) {
+                    ties = 0;
+                    bestScore = score;
+                }
+                if (score == bestScore && rng_() % ++ties == 0) {
+                    bestTurns = turns;
+                    bestColumn = column;
+                    bestRow = row;
+                }
+            }
+            // Plain 4x4 turn; the T's own table and kicks only make the aim rougher.
+            std::uint8_t turned[4] = {};
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 4; j++) {
+                    if (shape[i] >> j & 1) turned[j] |= 1u << (3 - i);
+                }
+            }
+            std::memcpy(shape, turned, sizeof(shape));
+        }
+    }
+};
+
+constexpr Op StreamWriter::NOISE[16];
+
+/** Seed of the game played after `games` top-outs within one stream */
+static unsigned streamSeed(unsigned seed, int games) {
+    return seed + 0x9E3779B9u * static_cast<unsigned>(games);
+}
+
+/**
+ * Play ops through both engines, comparing after reset and every tick; a
+ * top-out starts the stream's next game. With a writer the stream is
+ * written as it plays until it is ticks long.
+ */
+template <typename Candidate>
+static bool replay(Candidate& candidate, unsigned seed, std::vector<Op>& ops, Failure& failure,
+                   RunStats* stats = nullptr, StreamWriter* writer = nullptr, int ticks = 0) {
+    ReferenceEngine reference;
+    RulesState expected, actual;
+    int games = 0;
+    reference.reset(seed);
+    candidate.reset(seed);
+    reference.read(expected);
+    candidate.read(actual);
+    if (const char* field = firstDifference(expected, actual)) {
+        failure = {-1, field};
+        return false;
+    }
+
+    int length = writer ? ticks : static_cast<int>(ops.size());
+    for (int t = 0; t < length; t++) {
+        if (writer && t == static_cast<int>(ops.size())) writer->nextPiece(expected, ops);
+        reference.apply(ops[t]);
+        candidate.apply(ops[t]);
+        reference.read(expected);
+        candidate.read(actual);
+        if (const char* field = firstDifference(expected, actual)) {
+            failure = {t, field};
+            ops.resize(t + 1);
+            if (stats) stats->ticks += t + 1;
+            return false;
+        }
+        if (expected.gameOver) {
+            if (stats) {
+                stats->locks += expected.pieces;
+                stats->lines += expected.lines;
+                stats->tSpins += expected.tSpins;
+                stats->games++;
+            }
+            games++;
+            reference.reset(streamSeed(seed, games));
+            candidate.reset(streamSeed(seed, games));
+            reference.read(expected);
+        }
+    }
+    ops.resize(length);
+    if (stats) {
+        stats->ticks += length;
+        stats->locks += expected.pieces;
+        stats->lines += expected.lines;
+        stats->tSpins += expected.tSpins;
+    }
+    return true;
+}
+
+/** Delta-debug the stream: drop ever smaller chunks while it still diverges */
+template <typename Candidate>
+static std::vector<Op> shrink(Candidate& candidate, unsigned seed, std::vector<Op> ops, Failure& failure) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (std::size_t chunk = std::max<std::size_t>(ops.size() / 2, 1); chunk >= 1; chunk /= 2) {
+            for (std::size_t start = 0; start < ops.size();) {
+                std::vector<Op> trial(ops.begin(), ops.begin() + start);
+                trial.insert(trial.end(), ops.begin() + std::min(ops.size(), start + chunk), ops.end());
+                Failure trialFailure;
+                if (!replay(candidate, seed, trial, trialFailure)) {
+                    ops = trial;
+                    failure = trialFailure;
+                    progress = true;
+                } else {
+                    start += chunk;
+                }
+            }
+            if (chunk == 1) break;
+        }
+    }
+    return ops;
+}
+
+static void printState(const char* label, const RulesState& s) {
+    std::printf("  %-9s piece %d at (%d,%d) hold %d score %d lines %d combo %d b2b %d over %d\n",
+                label, s.current, s.x, s.y, s.hold, s.score, s.lines, s.combo, s.backToBack, s.gameOver);
+}
+
+static void printBoards(const RulesState& a, const RulesState& b) {
+    for (int r = 0; r < Rows::ROWS; r++) {
+        if (!a.rows.bits[r] && !b.rows.bits[r]) continue;
+        std::printf("  %2d |", r);
+        for (int c = 0; c < Rows::COLS; c++) std::putchar(a.rows.bits[r] >> c & 1 ? '#' : '.');
+        std::printf("|   |");
+        for (int c = 0; c < Rows::COLS; c++) std::putchar(b.rows.bits[r] >> c & 1 ? '#' : '.');
+        std::printf("|%s\n", a.rows.bits[r] != b.rows.bits[r] ? "  <" : "");
+    }
+}
+
+/** Rewrite the failing stream, shrink it and print both engines at the divergence */
+static void report(bool planted, unsigned seed, int ticks) {
+    BitboardEngine candidate(planted);
+    StreamWriter writer(seed);
+    std::vector<Op> ops;
+    Failure failure = {0, nullptr};
+    replay(candidate, seed, ops, failure, nullptr, &writer, ticks);
+    std::size_t written = ops.size();
+    ops = shrink(candidate, seed, ops, failure);
+    std::printf("MISMATCH in %s, seed %u: diverged at tick %zu, shrunk to %zu ticks\n",
+                failure.field, seed, written - 1, ops.size());
+    std::printf("  inputs:");
+    for (Op op : ops) std::printf(" %s", opNames[op]);
+    std::printf("\n");
+
+    // Replay the shrunk stream so both engines sit at the divergence.
+    ReferenceEngine reference;
+    RulesState expected, actual;
+    replay(candidate, seed, ops, failure);
+    reference.read(expected);
+    candidate.read(actual);
+    printState("reference", expected);
+    printState("candidate", actual);
+    printBoards(expected, actual);
+}
+
+int main(int argc, char** argv) {
+    int runs = 2000;
+    int ticks = 10000;
+    unsigned seed = 1;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    bool planted = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--plant") {
+            planted = true;
+            continue;
+        }
+        if (i + 1 >= argc) flag.clear();
+        int value = flag.empty() ? 0 : std::atoi(argv[++i]);
+        if (flag == "--runs") runs = std::max(1, value);
+        else if (flag == "--ticks") ticks = std::max(1, value);
+        else if (flag == "--seed") seed = static_cast<unsigned>(value);
+        else if (flag == "--threads") threadCount = std::max(1, value);
+        else {
+            std::fprintf(stderr, "usage: %s [--runs N] [--ticks N] [--seed N] [--threads N] [--plant]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Headless: no particles, sounds, telemetry or saved scores.
+    effectsEnabled = false;
+    gameMode = GameMode::MARATHON;
+    difficulty = Difficulty::NORMAL;
+    BitboardEngine::init();
+    if (threadCount > 1) Jobs::start(threadCount - 1);
+
+    std::vector<RunStats> stats(runs, RunStats{0, 0, 0, 0, 0});
+    std::atomic<int> firstFailure{runs};
+
+    auto start = std::chrono::steady_clock::now();
+    Jobs::parallelFor(0, runs, 1, [&](int run) {
+        if (run > firstFailure.load(std::memory_order_relaxed)) return;
+        BitboardEngine candidate(planted);
+        StreamWriter writer(seed + run);
+        std::vector<Op> ops;
+        ops.reserve(ticks + 2 * H);
+        Failure failure;
+        if (!replay(candidate, seed + run, ops, failure, &stats[run], &writer, ticks)) {
+            int seen = firstFailure.load();
+            while (run < seen && !firstFailure.compare_exchange_weak(seen, run)) {}
+        }
+    });
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Jobs::stop();
+
+    RunStats total = {0, 0, 0, 0, 0};
+    for (const RunStats& s : stats) {
+        total.ticks += s.ticks;
+        total.locks += s.locks;
+        total.lines += s.lines;
+        total.tSpins += s.tSpins;
+        total.games += s.games;
+    }
+    std::printf("fuzz: %lld ticks in %.2f s, %.2f M ticks/s on %u threads (%.2f M/s per thread)\n",
+                total.ticks, elapsed, total.ticks / elapsed / 1e6, threadCount,
+                total.ticks / elapsed / 1e6 / threadCount);
+    std::printf("  %lld pieces locked, %lld lines, %lld T-spins, %lld games topped out\n",
+                total.locks, total.lines, total.tSpins, total.games);
+
+    int failed = firstFailure.load();
+    if (failed < runs) {
+        report(planted, seed + failed, ticks);
+        return planted ? 0 : 1;
+    }
+    std::printf("OK: engines agree on every tick\n");
+    return planted ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * Tetris Game - Asset packer
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ *
+ * Usage: pack <assets dir> <output.pak>
+ * Bundles every file under the assets directory into one indexed archive
+ * that the game memory-maps at startup (see src/PackFormat.h).
+ */
+
+#include "../src/PackFormat.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <assets dir> <output.pak>\n", argv[0]);
+        return 1;
+    }
+
+    fs::path root = argv[1];
+    std::vector<std::string> names;
+    for (const auto& item : fs::recursive_directory_iterator(root)) {
+        if (!item.is_regular_file()) continue;
+        std::string name = fs::relative(item.path(), root).generic_string();
+        if (name.size() >= PACK_NAME_LEN) {
+            std::fprintf(stderr, "pack: name too long: %s\n", name.c_str());
+            return 1;
+        }
+        names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+
+    std::vector<PackEntry> index(names.size());
+    std::vector<std::vector<char>> blobs(names.size());
+    std::uint64_t offset = sizeof(PackHeader) + names.size() * sizeof(PackEntry);
+
+    for (std::size_t i = 0; i < names.size(); i++) {
+        std::ifstream in(root / names[i], std::ios::binary);
+        blobs[i].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        offset = (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+        std::memset(&index[i], 0, sizeof(PackEntry));
+        std::memcpy(index[i].name, names[i].c_str(), names[i].size());
+        index[i].offset = offset;
+        index[i].size = blobs[i].size();
+        offset += blobs[i].size();
+    }
+
+    PackHeader header = {};
+    std::memcpy(header.magic, PACK_MAGIC, 4);
+    header.version = PACK_VERSION;
+    header.count = static_cast<std::uint32_t>(names.size());
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::fprintf(stderr, "pack: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(PackEntry));
+
+    std::uint64_t written = sizeof(PackHeader) + index.size() * sizeof(PackEntry);
+    const char zeros[PACK_ALIGN] = {};
+    for (std::size_t i = 0; i < blobs.size(); i++) {
+        out.write(zeros, static_cast<std::streamsize>(index[i].offset - written));
+        out.write(blobs[i].data(), static_cast<std::streamsize>(blobs[i].size()));
+        written = index[i].offset + blobs[i].size();
+        std::printf("  %-40s %8llu bytes\n", names[i].c_str(), (unsigned long long)blobs[i].size());
+    }
+
+    std::printf("pack: %zu files, %llu bytes -> %s\n", names.size(), (unsigned long long)written, argv[2]);
+    return out ? 0 : 1;
+}
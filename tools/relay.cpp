@@ -0,0 +1,145 @@
+/*
+ * Tetris Game - Versus relay
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ *
+ * Usage: relay [--port N] [--delay ms] [--jitter ms] [--loss percent]
+ * Pairs the first two clients that say HELLO, sends both a START with a
+ * shared seed, then forwards INPUT datagrams between them. Delay, jitter
+ * and loss are applied to forwarded packets so rollback can be exercised
+ * on loopback (see src/NetProtocol.h).
+ */
+
+#include "../src/Net.h"
+#include "../src/NetProtocol.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Client {
+    Net::Address address;
+    HelloPacket hello;
+    int opponent;
+};
+
+struct Delayed {
+    double due;
+    Net::Address to;
+    InputPacket packet;
+};
+
+static double now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char** argv) {
+    int port = RELAY_PORT;
+    double delay = 0.0, jitter = 0.0, loss = 0.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        double value = std::atof(argv[i + 1]);
+        if (flag == "--port") port = static_cast<int>(value);
+        else if (flag == "--delay") delay = value / 1000.0;
+        else if (flag == "--jitter") jitter = value / 1000.0;
+        else if (flag == "--loss") loss = value / 100.0;
+        else {
+            std::fprintf(stderr, "usage: %s [--port N] [--delay ms] [--jitter ms] [--loss percent]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Net::Socket sock = Net::openUdp(static_cast<std::uint16_t>(port));
+    if (sock == Net::INVALID_SOCKET_HANDLE) {
+        std::fprintf(stderr, "relay: cannot bind UDP port %d\n", port);
+        return 1;
+    }
+    std::printf("relay: listening on UDP %d (delay %.0f ms, jitter %.0f ms, loss %.0f%%)\n",
+                port, delay * 1000.0, jitter * 1000.0, loss * 100.0);
+
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Client> clients;
+    std::vector<Delayed> queue;
+    int waiting = -1;
+
+    auto find = [&clients](const Net::Address& address) {
+        for (std::size_t i = 0; i < clients.size(); i++) {
+            if (Net::sameAddress(clients[i].address, address)) return static_cast<int>(i);
+        }
+        return -1;
+    };
+
+    while (true) {
+        unsigned char buffer[64];
+        Net::Address from;
+        int size;
+        while ((size = Net::receiveFrom(sock, from, buffer, sizeof(buffer))) > 0) {
+            int index = find(from);
+
+            if (buffer[0] == NET_HELLO && size == sizeof(HelloPacket)) {
+                if (index < 0) {
+                    clients.push_back({from, {}, -1});
+                    index = static_cast<int>(clients.size()) - 1;
+                }
+                Client& client = clients[index];
+                std::memcpy(&client.hello, buffer, sizeof(HelloPacket));
+                if (client.opponent >= 0) {
+                    clients[client.opponent].opponent = -1;
+                    client.opponent = -1;
+                }
+                if (waiting == index) continue;
+
+                if (waiting < 0) {
+                    waiting = index;
+                    std::printf("relay: %s waiting\n", Net::toString(from).c_str());
+                    continue;
+                }
+
+                Client& other = clients[waiting];
+                client.opponent = waiting;
+                other.opponent = index;
+                std::uint32_t seed = static_cast<std::uint32_t>(rng());
+                const Client* pair[2] = {&other, &client};
+                for (int p = 0; p < 2; p++) {
+                    StartPacket start = {};
+                    start.type = NET_START;
+                    start.playerIndex = static_cast<std::uint8_t>(p);
+                    start.seed = seed;
+                    start.opponentInstantSoftDrop = pair[1 - p]->hello.instantSoftDrop;
+                    start.opponentDasDelay = pair[1 - p]->hello.dasDelay;
+                    start.opponentArrDelay = pair[1 - p]->hello.arrDelay;
+                    Net::sendTo(sock, pair[p]->address, &start, sizeof(start));
+                }
+                std::printf("relay: match %s vs %s, seed %08x\n", Net::toString(other.address).c_str(),
+                            Net::toString(client.address).c_str(), seed);
+                waiting = -1;
+            } else if (buffer[0] == NET_INPUT && size == sizeof(InputPacket) && index >= 0 &&
+                       clients[index].opponent >= 0) {
+                if (unit(rng) < loss) continue;
+                Delayed item;
+                item.due = now() + delay + jitter * unit(rng);
+                item.to = clients[clients[index].opponent].address;
+                std::memcpy(&item.packet, buffer, sizeof(InputPacket));
+                queue.push_back(item);
+            }
+        }
+
+        double t = now();
+        for (std::size_t i = 0; i < queue.size();) {
+            if (queue[i].due <= t) {
+                Net::sendTo(sock, queue[i].to, &queue[i].packet, sizeof(InputPacket));
+                queue[i] = queue.back();
+                queue.pop_back();
+            } else {
+                i++;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
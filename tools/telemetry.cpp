@@ -0,0 +1,168 @@
+/*
+ * Tetris Game - Session telemetry analyzer
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ *
+ * Usage: telemetry <file.tlm | dir>...
+ * Reads every session file (directories are searched recursively) on all
+ * cores and prints per-player PPM/LPM percentiles and T-spin rates. Only
+ * the lockTime, piece, lines and tspin columns are read from each file
+ * (see src/TelemetryFormat.h).
+ */
+
+#include "../src/TelemetryFormat.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+const std::uint8_t T_PIECE = 2;
+
+struct PlayerStats {
+    std::vector<float> ppm;
+    std::vector<float> lpm;
+    std::uint64_t pieces = 0;
+    std::uint64_t lines = 0;
+    std::uint64_t tPieces = 0;
+    std::uint64_t tSpins = 0;
+
+    void merge(PlayerStats& other) {
+        ppm.insert(ppm.end(), other.ppm.begin(), other.ppm.end());
+        lpm.insert(lpm.end(), other.lpm.begin(), other.lpm.end());
+        pieces += other.pieces;
+        lines += other.lines;
+        tPieces += other.tPieces;
+        tSpins += other.tSpins;
+    }
+};
+
+typedef std::map<std::string, PlayerStats> StatsMap;
+
+/** Read one column into out; false when missing or malformed */
+template <typename T>
+static bool readColumn(std::ifstream& in, const std::vector<TelemetryColumn>& table,
+                       const char* name, std::uint32_t rows, std::vector<T>& out) {
+    for (const TelemetryColumn& column : table) {
+        if (std::strncmp(column.name, name, TELEMETRY_NAME_LEN) != 0) continue;
+        if (column.elementSize != sizeof(T)) return false;
+        out.resize(rows);
+        in.seekg(static_cast<std::streamoff>(column.offset));
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(out.data()), rows * sizeof(T)));
+    }
+    return false;
+}
+
+/** Fold one session file into stats; false when it is not a readable session */
+static bool analyzeSession(const fs::path& path, StatsMap& stats) {
+    std::ifstream in(path, std::ios::binary);
+    TelemetryHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, TELEMETRY_MAGIC, 4) != 0 || header.version != TELEMETRY_VERSION) return false;
+    if (header.rowCount == 0) return true;
+
+    std::vector<TelemetryColumn> table(header.columnCount);
+    if (!in.read(reinterpret_cast<char*>(table.data()), table.size() * sizeof(TelemetryColumn))) return false;
+
+    std::vector<float> lockTimes;
+    std::vector<std::uint8_t> pieces, lines, tSpins;
+    if (!readColumn(in, table, "lockTime", header.rowCount, lockTimes) ||
+        !readColumn(in, table, "piece", header.rowCount, pieces) ||
+        !readColumn(in, table, "lines", header.rowCount, lines) ||
+        !readColumn(in, table, "tspin", header.rowCount, tSpins)) {
+        return false;
+    }
+
+    char player[TELEMETRY_PLAYER_LEN + 1] = {};
+    std::memcpy(player, header.player, TELEMETRY_PLAYER_LEN);
+    PlayerStats& s = stats[player];
+
+    std::uint64_t sessionLines = 0;
+    for (std::uint32_t i = 0; i < header.rowCount; i++) {
+        sessionLines += lines[i];
+        if (pieces[i] == T_PIECE) {
+            s.tPieces++;
+            s.tSpins += tSpins[i];
+        }
+    }
+    s.pieces += header.rowCount;
+    s.lines += sessionLines;
+
+    float minutes = lockTimes.back() / 60.f;
+    if (minutes > 0.f) {
+        s.ppm.push_back(header.rowCount / minutes);
+        s.lpm.push_back(sessionLines / minutes);
+    }
+    return true;
+}
+
+/** Nearest-rank percentile; reorders values */
+static float percentile(std::vector<float>& values, float p) {
+    if (values.empty()) return 0.f;
+    std::size_t rank = static_cast<std::size_t>(p / 100.f * (values.size() - 1) + 0.5f);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file.tlm | dir>...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<fs::path> files;
+    for (int i = 1; i < argc; i++) {
+        fs::path arg = argv[i];
+        if (fs::is_directory(arg)) {
+            for (const auto& item : fs::recursive_directory_iterator(arg)) {
+                if (item.is_regular_file() && item.path().extension() == ".tlm") files.push_back(item.path());
+            }
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<StatsMap> partial(threadCount);
+    std::atomic<std::size_t> nextFile(0);
+    std::atomic<std::size_t> skipped(0);
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t] {
+            for (std::size_t i = nextFile++; i < files.size(); i = nextFile++) {
+                if (!analyzeSession(files[i], partial[t])) {
+                    std::fprintf(stderr, "telemetry: skipping %s\n", files[i].string().c_str());
+                    skipped++;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    StatsMap stats;
+    for (StatsMap& part : partial) {
+        for (auto& item : part) stats[item.first].merge(item.second);
+    }
+
+    std::printf("%zu sessions, %zu skipped\n\n", files.size() - skipped, skipped.load());
+    std::printf("%-20s %8s %8s %8s %8s %8s %8s %8s %9s\n",
+                "player", "sessions", "PPM p50", "PPM p90", "PPM p99", "LPM p50", "LPM p90", "LPM p99", "T-spin %");
+    for (auto& item : stats) {
+        PlayerStats& s = item.second;
+        float tSpinRate = s.tPieces ? 100.f * s.tSpins / s.tPieces : 0.f;
+        std::printf("%-20s %8zu %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f %9.1f\n",
+                    item.first.c_str(), s.ppm.size(),
+                    percentile(s.ppm, 50), percentile(s.ppm, 90), percentile(s.ppm, 99),
+                    percentile(s.lpm, 50), percentile(s.lpm, 90), percentile(s.lpm, 99),
+                    tSpinRate);
+    }
+    return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * Tetris Game - Bot evaluation weight tuner
+ * Copyright (C) 2025 Tetris Game Contributors
+ * Licensed under GPL v3 - see LICENSE file
+ *
+ * Usage: tuner [--generations N] [--population N] [--games N] [--pieces N]
+ *              [--depth 1|2] [--threads N] [--seed N] [--checkpoint file]
+ * Evolves Bot::Weights with a genetic algorithm. Every generation plays
+ * population x games headless games on all cores with the real engine
+ * (7-bag, scoring, lock delay); all candidates get the same seeds, and
+ * fitness is the mean score. The state is checkpointed atomically after
+ * every generation; when the checkpoint exists the run resumes from it
+ * and only --generations and --threads apply.
+ */
+
+#include "../src/Bot.h"
+#include "../src/Game.h"
+#include "../src/Jobs.h"
+#include "../src/Persist.h"
+#include "../src/TransTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+const int ELITES = 2;
+const int TOURNAMENT = 3;
+const float MUTATION_RATE = 0.2f;
+const float MUTATION_SIZE = 0.15f;
+
+struct Settings {
+    int population = 24;
+    int games = 16;
+    int pieces = 500;
+    int depth = 2;
+    unsigned seed = 1;
+};
+
+struct Individual {
+    Bot::Weights weights;
+    double fitness = 0.0;
+};
+
+struct TunerState {
+    Settings settings;
+    int generation = 0;
+    long long gamesPlayed = 0;
+    double seconds = 0.0;
+    std::mt19937_64 rng;
+    std::vector<Individual> population;
+};
+
+static void normalize(Bot::Weights& w) {
+    double length = 0.0;
+    for (float v : w.values) length += v * v;
+    if (length <= 0.0) return;
+    float scale = static_cast<float>(1.0 / std::sqrt(length));
+    for (float& v : w.values) v *= scale;
+}
+
+/** Same seeds for every candidate in a generation, new ones each generation */
+static unsigned seedFor(const Settings& settings, int generation, int game) {
+    std::uint64_t z = settings.seed + 0x9E3779B97F4A7C15ull * (static_cast<std::uint64_t>(generation) * 65536 + game + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<unsigned>(z ^ (z >> 31));
+}
+
+static void seedPopulation(TunerState& state) {
+    std::normal_distribution<float> noise(0.f, 0.3f);
+    state.population.assign(state.settings.population, Individual());
+    for (int i = 0; i < state.settings.population; i++) {
+        Bot::Weights& w = state.population[i].weights;
+        w = Bot::defaultWeights();
+        normalize(w);
+        if (i == 0) continue;
+        for (float& v : w.values) v += noise(state.rng);
+        normalize(w);
+    }
+}
+
+static std::string serialize(const TunerState& state) {
+    std::ostringstream out;
+    out.precision(9);
+    out << "tuner-checkpoint 1\n";
+    out << "generation " << state.generation << "\n";
+    out << "settings " << state.settings.population << " " << state.settings.games << " "
+        << state.settings.pieces << " " << state.settings.depth << " " << state.settings.seed << "\n";
+    out << "totals " << state.gamesPlayed << " " << state.seconds << "\n";
+    out << "rng " << state.rng << "\n";
+    for (const Individual& ind : state.population) {
+        out << "individual " << ind.fitness;
+        for (float v : ind.weights.values) out << " " << v;
+        out << "\n";
+    }
+    return out.str();
+}
+
+static bool loadCheckpoint(const std::string& path, TunerState& state) {
+    std::ifstream in(path);
+    std::string line, tag;
+    if (!std::getline(in, line) || line != "tuner-checkpoint 1") return false;
+
+    state.population.clear();
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        fields >> tag;
+        if (tag == "generation") {
+            fields >> state.generation;
+        } else if (tag == "settings") {
+            Settings& s = state.settings;
+            fields >> s.population >> s.games >> s.pieces >> s.depth >> s.seed;
+        } else if (tag == "totals") {
+            fields >> state.gamesPlayed >> state.seconds;
+        } else if (tag == "rng") {
+            fields >> state.rng;
+        } else if (tag == "individual") {
+            Individual ind;
+            fields >> ind.fitness;
+            for (float& v : ind.weights.values) fields >> v;
+            state.population.push_back(ind);
+        }
+        if (fields.fail()) return false;
+    }
+    return static_cast<int>(state.population.size()) == state.settings.population;
+}
+
+/** Play every candidate's games across the threads and set its mean score */
+static void evaluate(TunerState& state) {
+    const Settings& s = state.settings;
+    int jobs = s.population * s.games;
+    std::vector<long long> scores(jobs);
+    bool lookahead = s.depth > 1;
+
+    TransTable::newSearch();
+    Jobs::parallelFor(0, jobs, 1, [&](int job) {
+        const Individual& ind = state.population[job / s.games];
+        unsigned seed = seedFor(s, state.generation, job % s.games);
+        scores[job] = Bot::playGame(ind.weights, seed, s.pieces, lookahead).score;
+    });
+
+    for (int i = 0; i < s.population; i++) {
+        long long total = std::accumulate(scores.begin() + i * s.games, scores.begin() + (i + 1) * s.games, 0LL);
+        state.population[i].fitness = static_cast<double>(total) / s.games;
+    }
+}
+
+static const Individual& tournament(const std::vector<Individual>& ranked, std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(ranked.size()) - 1);
+    int best = pick(rng);
+    for (int i = 1; i < TOURNAMENT; i++) best = std::min(best, pick(rng));
+    return ranked[best];
+}
+
+/** Keep the elites; breed the rest by fitness-weighted blend and mutation */
+static void breed(TunerState& state) {
+    std::vector<Individual>& ranked = state.population;
+    std::sort(ranked.begin(), ranked.end(),
+              [](const Individual& a, const Individual& b) { return a.fitness > b.fitness; });
+
+    std::uniform_real_distribution<float> chance(0.f, 1.f);
+    std::normal_distribution<float> noise(0.f, MUTATION_SIZE);
+    std::vector<Individual> next(ranked.begin(), ranked.begin() + std::min<int>(ELITES, ranked.size()));
+    while (static_cast<int>(next.size()) < state.settings.population) {
+        const Individual& a = tournament(ranked, state.rng);
+        const Individual& b = tournament(ranked, state.rng);
+        double fa = std::max(a.fitness, 1.0), fb = std::max(b.fitness, 1.0);
+
+        Individual child;
+        for (int k = 0; k < Features::FEATURE_COUNT; k++) {
+            child.weights.values[k] = static_cast<float>((a.weights.values[k] * fa + b.weights.values[k] * fb) / (fa + fb));
+            if (chance(state.rng) < MUTATION_RATE) child.weights.values[k] += noise(state.rng);
+        }
+        normalize(child.weights);
+        next.push_back(child);
+    }
+    state.population = next;
+}
+
+static void printWeights(const Bot::Weights& w) {
+    for (int k = 0; k < Features::FEATURE_COUNT; k++) {
+        std::printf("  %-18s %+.4f\n", Features::name(k), w.values[k]);
+    }
+}
+
+int main(int argc, char** argv) {
+    TunerState state;
+    int generations = 20;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::string checkpoint = "tuner.ckpt";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        int value = std::atoi(argv[i + 1]);
+        if (flag == "--generations") generations = value;
+        else if (flag == "--population") state.settings.population = std::max(ELITES + 1, value);
+        else if (flag == "--games") state.settings.games = std::max(1, value);
+        else if (flag == "--pieces") state.settings.pieces = std::max(1, value);
+        else if (flag == "--depth") state.settings.depth = std::min(2, std::max(1, value));
+        else if (flag == "--threads") threadCount = std::max(1, value);
+        else if (flag == "--seed") state.settings.seed = static_cast<unsigned>(value);
+        else if (flag == "--checkpoint") checkpoint = argv[i + 1];
+        else {
+            std::fprintf(stderr, "usage: %s [--generations N] [--population N] [--games N] [--pieces N] "
+                                 "[--depth 1|2] [--threads N] [--seed N] [--checkpoint file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Headless: no particles, sounds, telemetry or saved scores.
+    effectsEnabled = false;
+    gameMode = GameMode::MARATHON;
+    difficulty = Difficulty::NORMAL;
+    TransTable::init();
+    Bot::init();
+    if (threadCount > 1) Jobs::start(threadCount - 1);
+
+    if (loadCheckpoint(checkpoint, state)) {
+        std::printf("resuming %s at generation %d (%lld games so far)\n",
+                    checkpoint.c_str(), state.generation, state.gamesPlayed);
+    } else {
+        state.generation = 0;
+        state.gamesPlayed = 0;
+        state.seconds = 0.0;
+        state.rng.seed(state.settings.seed);
+        seedPopulation(state);
+    }
+
+    const Settings& s = state.settings;
+    std::printf("population %d, %d games of up to %d pieces each, depth %d, %u threads\n",
+                s.population, s.games, s.pieces, s.depth, threadCount);
+
+    auto sessionStart = std::chrono::steady_clock::now();
+    for (int g = 0; g < generations; g++) {
+        auto start = std::chrono::steady_clock::now();
+        evaluate(state);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double session = std::chrono::duration<double>(std::chrono::steady_clock::now() - sessionStart).count();
+        int games = s.population * s.games;
+        state.gamesPlayed += games;
+        state.seconds += elapsed;
+
+        const Individual& best = *std::max_element(state.population.begin(), state.population.end(),
+            [](const Individual& a, const Individual& b) { return a.fitness < b.fitness; });
+        double mean = 0.0;
+        for (const Individual& ind : state.population) mean += ind.fitness / s.population;
+        std::printf("gen %4d  best %9.0f  mean %9.0f  %7.1f games/s  %7.1f gen/h  TT %3d%%\n",
+                    state.generation, best.fitness, mean, games / elapsed,
+                    (g + 1) * 3600.0 / session, TransTable::occupancyPermille() / 10);
+        if (g + 1 == generations) printWeights(best.weights);
+        std::fflush(stdout);
+
+        breed(state);
+        state.generation++;
+        if (!Persist::writeAtomic(checkpoint, serialize(state))) {
+            std::fprintf(stderr, "tuner: could not write %s\n", checkpoint.c_str());
+        }
+    }
+
+    if (state.seconds > 0.0) {
+        std::printf("total: %d generations, %lld games, %.1f games/s, %.1f gen/h\n",
+                    state.generation, state.gamesPlayed, state.gamesPlayed / state.seconds,
+                    state.generation * 3600.0 / state.seconds);
+    }
+    Jobs::stop();
+    return 0;
+}